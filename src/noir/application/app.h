@@ -4,6 +4,7 @@
 // SPDX-License-Identifier: AGPL-3.0-or-later
 //
 #pragma once
+#include <noir/common/check.h>
 #include <noir/consensus/abci_types.h>
 #include <tendermint/abci/types.pb.h>
 
@@ -36,6 +37,16 @@ public:
     return std::make_unique<ResponseCommit>();
   }
 
+  /// \brief returns true if rollback() is able to discard uncommitted state changes
+  /// Applications opt in by overriding both this and rollback().
+  virtual bool supports_rollback() const {
+    return false;
+  }
+  /// \brief discards state changes made by begin_block, deliver_tx and end_block since the last commit
+  virtual void rollback() {
+    check(false, "application does not support rollback");
+  }
+
   virtual std::unique_ptr<ResponseCheckTx> check_tx_sync() {
     return {};
   }
@@ -25,6 +25,12 @@ public:
     // ilog("!!! DeliverTx !!!");
     return {};
   }
+
+  // keeps no state, so there is nothing to discard
+  virtual bool supports_rollback() const override {
+    return true;
+  }
+  virtual void rollback() override {}
 };
 
 } // namespace noir::application
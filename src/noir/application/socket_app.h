@@ -22,6 +22,11 @@ public:
 
   virtual std::unique_ptr<ResponseCommit> commit() override;
 
+  // ABCI has no request for discarding uncommitted state
+  virtual bool supports_rollback() const override {
+    return false;
+  }
+
 private:
   std::shared_ptr<struct cli_impl> my_cli;
 };
@@ -5,10 +5,65 @@
 //
 #pragma once
 #include <noir/codec/datastream.h>
+#include <google/protobuf/io/zero_copy_stream.h>
 #include <google/protobuf/message_lite.h>
+#include <algorithm>
+#include <limits>
+#include <vector>
 
 namespace noir::codec::protobuf {
 
+/// \brief input stream over a sequence of buffers, to parse a message split into several buffers without
+/// concatenating them
+class span_list_input_stream : public google::protobuf::io::ZeroCopyInputStream {
+public:
+  explicit span_list_input_stream(std::vector<std::span<const unsigned char>> spans_): spans(std::move(spans_)) {}
+
+  bool Next(const void** data, int* size) override {
+    while (index < spans.size() && offset == spans[index].size()) {
+      index++;
+      offset = 0;
+    }
+    if (index == spans.size())
+      return false;
+    auto n = std::min<size_t>(spans[index].size() - offset, std::numeric_limits<int>::max());
+    *data = spans[index].data() + offset;
+    *size = static_cast<int>(n);
+    offset += n;
+    position += n;
+    return true;
+  }
+
+  void BackUp(int count) override {
+    offset -= count;
+    position -= count;
+  }
+
+  bool Skip(int count) override {
+    while (count > 0 && index < spans.size()) {
+      auto n = std::min<size_t>(spans[index].size() - offset, count);
+      offset += n;
+      position += n;
+      count -= static_cast<int>(n);
+      if (offset == spans[index].size()) {
+        index++;
+        offset = 0;
+      }
+    }
+    return count == 0;
+  }
+
+  int64_t ByteCount() const override {
+    return position;
+  }
+
+private:
+  std::vector<std::span<const unsigned char>> spans;
+  size_t index{0};
+  size_t offset{0};
+  int64_t position{0};
+};
+
 template<typename T>
 constexpr size_t encode_size(const T& v) {
   return v.ByteSizeLong();
@@ -33,4 +88,11 @@ void decode(std::span<const unsigned char> s, T& v) {
   v.ParseFromArray(s.data(), s.size());
 }
 
+/// \brief decodes a message serialized across several buffers in one pass, without concatenating them
+template<typename T>
+void decode(std::vector<std::span<const unsigned char>> spans, T& v) {
+  span_list_input_stream in(std::move(spans));
+  v.ParseFromZeroCopyStream(&in);
+}
+
 } // namespace noir::codec::protobuf
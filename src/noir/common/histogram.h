@@ -0,0 +1,101 @@
+// This file is part of NOIR.
+//
+// Copyright (c) 2022 Haderech Pte. Ltd.
+// SPDX-License-Identifier: AGPL-3.0-or-later
+//
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace noir {
+
+/// \brief histogram of non-negative integers with bounded relative error, in the manner of HdrHistogram
+/// Values below 2^significant_bits are counted exactly; larger values share a bucket with values having the same
+/// `significant_bits` leading bits, so a reported value is within 2^(1 - significant_bits) of a recorded one.
+/// Memory use is fixed regardless of the number or range of recorded values.
+/// \note not thread safe
+/// \ingroup common
+template<uint32_t significant_bits = 5>
+class basic_histogram {
+  static_assert(significant_bits >= 1 && significant_bits < 32);
+  static constexpr uint64_t exact_range = uint64_t{1} << significant_bits;
+  static constexpr uint64_t sub_buckets = exact_range / 2;
+  static constexpr size_t num_buckets = exact_range + (64 - significant_bits) * sub_buckets;
+
+public:
+  basic_histogram(): counts(num_buckets, 0) {}
+
+  void record(uint64_t value) {
+    counts[bucket_of(value)]++;
+    total++;
+    sum += value;
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+  }
+
+  uint64_t count() const {
+    return total;
+  }
+  uint64_t min() const {
+    return total ? min_ : 0;
+  }
+  uint64_t max() const {
+    return max_;
+  }
+  double mean() const {
+    return total ? static_cast<double>(sum) / total : 0;
+  }
+
+  /// \brief returns the smallest value at or below which the given fraction of recorded values fall
+  /// \param[in] q quantile in [0, 1]
+  uint64_t value_at_quantile(double q) const {
+    if (!total)
+      return 0;
+    auto rank = static_cast<uint64_t>(std::clamp(q, 0.0, 1.0) * total + 0.5);
+    rank = std::clamp<uint64_t>(rank, 1, total);
+    uint64_t seen{0};
+    for (size_t i = 0; i < num_buckets; i++) {
+      seen += counts[i];
+      if (seen >= rank)
+        return std::clamp(highest_in_bucket(i), min_, max_);
+    }
+    return max_;
+  }
+
+  void reset() {
+    std::fill(counts.begin(), counts.end(), 0);
+    total = 0;
+    sum = 0;
+    min_ = std::numeric_limits<uint64_t>::max();
+    max_ = 0;
+  }
+
+private:
+  static size_t bucket_of(uint64_t value) {
+    if (value < exact_range)
+      return value;
+    auto shift = std::bit_width(value) - significant_bits;
+    return exact_range + (shift - 1) * sub_buckets + ((value >> shift) - sub_buckets);
+  }
+
+  static uint64_t highest_in_bucket(size_t bucket) {
+    if (bucket < exact_range)
+      return bucket;
+    auto shift = (bucket - exact_range) / sub_buckets + 1;
+    auto leading = (bucket - exact_range) % sub_buckets + sub_buckets;
+    return ((leading + 1) << shift) - 1;
+  }
+
+  std::vector<uint64_t> counts;
+  uint64_t total{0};
+  uint64_t sum{0};
+  uint64_t min_{std::numeric_limits<uint64_t>::max()};
+  uint64_t max_{0};
+};
+
+using histogram = basic_histogram<>;
+
+} // namespace noir
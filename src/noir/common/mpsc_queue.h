@@ -0,0 +1,62 @@
+// This file is part of NOIR.
+//
+// Copyright (c) 2022 Haderech Pte. Ltd.
+// SPDX-License-Identifier: AGPL-3.0-or-later
+//
+#pragma once
+#include <atomic>
+#include <optional>
+
+namespace noir {
+
+/// \brief lock-free multi-producer single-consumer queue
+/// push() may be called from any thread, while pop() must only be called from a single consumer thread.
+/// Based on Dmitry Vyukov's non-intrusive MPSC node-based queue.
+/// \ingroup common
+template<typename T>
+class mpsc_queue {
+public:
+  mpsc_queue(): head_(new node), tail_(head_.load()) {}
+  mpsc_queue(const mpsc_queue&) = delete;
+  mpsc_queue& operator=(const mpsc_queue&) = delete;
+
+  ~mpsc_queue() {
+    while (pop()) {
+    }
+    delete tail_;
+  }
+
+  void push(T v) {
+    auto n = new node{std::move(v)};
+    auto prev = head_.exchange(n, std::memory_order_acq_rel);
+    // NOTE: the queue is briefly disconnected here; the consumer sees it as empty until the link is published
+    prev->next.store(n, std::memory_order_release);
+  }
+
+  std::optional<T> pop() {
+    auto next = tail_->next.load(std::memory_order_acquire);
+    if (!next) {
+      return std::nullopt;
+    }
+    std::optional<T> ret = std::move(next->value);
+    next->value.reset();
+    delete tail_;
+    tail_ = next;
+    return ret;
+  }
+
+  bool empty() const {
+    return !tail_->next.load(std::memory_order_acquire);
+  }
+
+private:
+  struct node {
+    std::optional<T> value;
+    std::atomic<node*> next{nullptr};
+  };
+
+  std::atomic<node*> head_;
+  node* tail_;
+};
+
+} // namespace noir
@@ -0,0 +1,51 @@
+// This file is part of NOIR.
+//
+// Copyright (c) 2022 Haderech Pte. Ltd.
+// SPDX-License-Identifier: AGPL-3.0-or-later
+//
+#include <catch2/catch_all.hpp>
+#include <noir/common/histogram.h>
+#include <algorithm>
+#include <random>
+
+using namespace noir;
+
+TEST_CASE("histogram: exact small values", "[noir][common]") {
+  histogram h;
+  CHECK(h.count() == 0);
+  CHECK(h.value_at_quantile(0.5) == 0);
+
+  for (uint64_t v = 1; v <= 10; v++)
+    h.record(v);
+  CHECK(h.count() == 10);
+  CHECK(h.min() == 1);
+  CHECK(h.max() == 10);
+  CHECK(h.mean() == 5.5);
+  CHECK(h.value_at_quantile(0.5) == 5);
+  CHECK(h.value_at_quantile(1.0) == 10);
+
+  h.reset();
+  CHECK(h.count() == 0);
+  CHECK(h.max() == 0);
+}
+
+TEST_CASE("histogram: relative error", "[noir][common]") {
+  histogram h;
+  std::mt19937_64 rng(1);
+  std::vector<uint64_t> values;
+  for (auto i = 0; i < 10000; i++) {
+    auto v = rng() >> (rng() % 64);
+    values.push_back(v);
+    h.record(v);
+  }
+  std::sort(values.begin(), values.end());
+
+  for (auto q : {0.01, 0.5, 0.9, 0.99, 0.999}) {
+    auto expected = values[static_cast<size_t>(q * values.size() + 0.5) - 1];
+    auto actual = h.value_at_quantile(q);
+    CHECK(actual >= expected);
+    CHECK(actual - expected <= expected / 16);
+  }
+  CHECK(h.value_at_quantile(1.0) == values.back());
+  CHECK(h.value_at_quantile(0.0) == values.front());
+}
@@ -0,0 +1,55 @@
+// This file is part of NOIR.
+//
+// Copyright (c) 2022 Haderech Pte. Ltd.
+// SPDX-License-Identifier: AGPL-3.0-or-later
+//
+#include <catch2/catch_all.hpp>
+#include <noir/common/mpsc_queue.h>
+#include <thread>
+#include <vector>
+
+using namespace noir;
+
+TEST_CASE("mpsc_queue: single thread", "[noir][common]") {
+  mpsc_queue<std::string> q;
+  CHECK(q.empty());
+  CHECK(!q.pop());
+
+  q.push("a");
+  q.push("b");
+  CHECK(!q.empty());
+  CHECK(q.pop() == "a");
+  CHECK(q.pop() == "b");
+  CHECK(!q.pop());
+  CHECK(q.empty());
+}
+
+TEST_CASE("mpsc_queue: multiple producers", "[noir][common]") {
+  static constexpr int num_producers = 4;
+  static constexpr int num_items = 10000;
+  mpsc_queue<std::pair<int, int>> q;
+
+  std::vector<std::thread> producers;
+  for (auto p = 0; p < num_producers; ++p) {
+    producers.emplace_back([&q, p]() {
+      for (auto i = 0; i < num_items; ++i) {
+        q.push({p, i});
+      }
+    });
+  }
+
+  // items from the same producer must come out in order
+  std::vector<int> next(num_producers, 0);
+  auto received = 0;
+  while (received < num_producers * num_items) {
+    if (auto v = q.pop(); v) {
+      CHECK(v->second == next[v->first]);
+      ++next[v->first];
+      ++received;
+    }
+  }
+  for (auto& t : producers) {
+    t.join();
+  }
+  CHECK(q.empty());
+}
@@ -0,0 +1,85 @@
+// This file is part of NOIR.
+//
+// Copyright (c) 2022 Haderech Pte. Ltd.
+// SPDX-License-Identifier: AGPL-3.0-or-later
+//
+#include <noir/consensus/adaptive_timeouts.h>
+#include <algorithm>
+#include <vector>
+
+namespace noir::consensus {
+
+void adaptive_timeouts::latency::start_at(int64_t height_, int32_t round_, clock::time_point now) {
+  height = height_;
+  round = round_;
+  start = now;
+}
+
+void adaptive_timeouts::latency::end_at(int64_t height_, int32_t round_, clock::time_point now) {
+  // only the first completion in a height, and only of the round whose step start was seen
+  if (height_ != height || round_ != round || start == clock::time_point{} || sampled_height == height)
+    return;
+  sampled_height = height;
+  samples.push_back(now - start);
+  if (samples.size() > window_size)
+    samples.pop_front();
+}
+
+std::optional<std::chrono::system_clock::duration> adaptive_timeouts::latency::timeout(
+  const consensus_config& cfg) const {
+  if (!cfg.adaptive_timeouts || samples.empty())
+    return std::nullopt;
+  std::vector<clock::duration> sorted(samples.begin(), samples.end());
+  auto percentile = std::clamp<uint32_t>(cfg.timeout_adaptive_percentile, 1, 100);
+  // nearest rank
+  auto rank = (sorted.size() * percentile + 99) / 100;
+  auto nth = sorted.begin() + (rank - 1);
+  std::nth_element(sorted.begin(), nth, sorted.end());
+  auto t = std::chrono::duration_cast<std::chrono::system_clock::duration>(*nth) + cfg.timeout_adaptive_margin;
+  return std::clamp(t, cfg.timeout_adaptive_min, std::max(cfg.timeout_adaptive_min, cfg.timeout_adaptive_max));
+}
+
+void adaptive_timeouts::enter_step(int64_t height, int32_t round, p2p::round_step_type step, clock::time_point now) {
+  switch (step) {
+  case p2p::round_step_type::Propose:
+    propose_latency.start_at(height, round, now);
+    break;
+  case p2p::round_step_type::Prevote:
+    prevote_latency.start_at(height, round, now);
+    break;
+  case p2p::round_step_type::Precommit:
+    precommit_latency.start_at(height, round, now);
+    break;
+  default:
+    break;
+  }
+}
+
+void adaptive_timeouts::complete_proposal(int64_t height, int32_t round, clock::time_point now) {
+  propose_latency.end_at(height, round, now);
+}
+
+void adaptive_timeouts::reach_quorum(
+  int64_t height, int32_t round, p2p::signed_msg_type type, clock::time_point now) {
+  if (type == p2p::Prevote)
+    prevote_latency.end_at(height, round, now);
+  else if (type == p2p::Precommit)
+    precommit_latency.end_at(height, round, now);
+}
+
+std::chrono::system_clock::duration adaptive_timeouts::propose(const consensus_config& cfg, int32_t round) const {
+  auto base = propose_latency.timeout(cfg);
+  return base ? *base + (cfg.propose(round) - cfg.propose(0)) : cfg.propose(round);
+}
+
+std::chrono::system_clock::duration adaptive_timeouts::prevote(const consensus_config& cfg, int32_t round) const {
+  auto base = prevote_latency.timeout(cfg);
+  return base ? *base + (cfg.prevote(round) - cfg.prevote(0)) : cfg.prevote(round);
+}
+
+std::chrono::system_clock::duration adaptive_timeouts::precommit(const consensus_config& cfg, int32_t round) const {
+  auto base = precommit_latency.timeout(cfg);
+  return base ? *base + (cfg.precommit(round) - cfg.precommit(0)) : cfg.precommit(round);
+}
+
+} // namespace noir::consensus
@@ -0,0 +1,59 @@
+// This file is part of NOIR.
+//
+// Copyright (c) 2022 Haderech Pte. Ltd.
+// SPDX-License-Identifier: AGPL-3.0-or-later
+//
+#pragma once
+#include <noir/consensus/config.h>
+#include <noir/p2p/protocol.h>
+#include <noir/p2p/types.h>
+#include <chrono>
+#include <deque>
+#include <optional>
+
+namespace noir::consensus {
+
+/// \brief propose, prevote and precommit timeouts derived from latencies observed in recent heights
+///
+/// One sample of each latency is taken per height, from the round in which the step was entered:
+/// - propose: from entering Propose until the proposal block is complete
+/// - prevote: from entering Prevote until +2/3 prevotes for a single block
+/// - precommit: from entering Precommit until +2/3 precommits for a single block
+///
+/// The timeout of round 0 is the configured percentile of the samples plus a margin, clamped to
+/// [timeout_adaptive_min, timeout_adaptive_max]. Later rounds add the configured per-round deltas on top, so timeouts
+/// keep growing with rounds as they do with static timeouts. Until a sample is taken, or when adaptive_timeouts is
+/// off, static timeouts are used.
+class adaptive_timeouts {
+public:
+  using clock = std::chrono::steady_clock;
+  static constexpr size_t window_size = 100; ///< number of recent heights to take samples from
+
+  void enter_step(int64_t height, int32_t round, p2p::round_step_type step, clock::time_point now = clock::now());
+  void complete_proposal(int64_t height, int32_t round, clock::time_point now = clock::now());
+  void reach_quorum(int64_t height, int32_t round, p2p::signed_msg_type type, clock::time_point now = clock::now());
+
+  std::chrono::system_clock::duration propose(const consensus_config& cfg, int32_t round) const;
+  std::chrono::system_clock::duration prevote(const consensus_config& cfg, int32_t round) const;
+  std::chrono::system_clock::duration precommit(const consensus_config& cfg, int32_t round) const;
+
+private:
+  struct latency {
+    int64_t height{};
+    int32_t round{};
+    clock::time_point start{};
+    int64_t sampled_height{};
+    std::deque<clock::duration> samples;
+
+    void start_at(int64_t height_, int32_t round_, clock::time_point now);
+    void end_at(int64_t height_, int32_t round_, clock::time_point now);
+    /// \return timeout of round 0, or nothing if no sample is taken yet
+    std::optional<std::chrono::system_clock::duration> timeout(const consensus_config& cfg) const;
+  };
+
+  latency propose_latency;
+  latency prevote_latency;
+  latency precommit_latency;
+};
+
+} // namespace noir::consensus
@@ -50,6 +50,18 @@ std::unique_ptr<tendermint::abci::ResponseCommit> app_connection::commit_sync()
   return std::move(application->commit());
 }
 
+bool app_connection::supports_rollback() {
+  std::scoped_lock g(mtx);
+  return application->supports_rollback();
+}
+bool app_connection::rollback_sync() {
+  std::scoped_lock g(mtx);
+  if (!application->supports_rollback())
+    return false;
+  application->rollback();
+  return true;
+}
+
 std::unique_ptr<tendermint::abci::ResponseCheckTx> app_connection::check_tx_sync(request_check_tx req) {
   std::scoped_lock g(mtx);
   return {};
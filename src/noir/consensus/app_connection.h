@@ -17,6 +17,8 @@ struct app_connection {
   std::unique_ptr<tendermint::abci::ResponseEndBlock> end_block_sync(const tendermint::abci::RequestEndBlock&);
   std::unique_ptr<tendermint::abci::ResponseDeliverTx> deliver_tx_async(const tendermint::abci::RequestDeliverTx&);
   std::unique_ptr<tendermint::abci::ResponseCommit> commit_sync();
+  bool supports_rollback();
+  bool rollback_sync();
 
   std::unique_ptr<tendermint::abci::ResponseCheckTx> check_tx_sync(request_check_tx req);
   std::unique_ptr<tendermint::abci::ResponseCheckTx> check_tx_async(request_check_tx req);
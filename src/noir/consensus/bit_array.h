@@ -9,6 +9,7 @@
 #include <tendermint/libs/bits/types.pb.h>
 
 #include <algorithm>
+#include <bit>
 #include <memory>
 #include <mutex>
 #include <random>
@@ -18,7 +19,8 @@ namespace noir::consensus {
 
 struct bit_array : public std::enable_shared_from_this<bit_array> {
   int bits{};
-  std::vector<bool> elem;
+  /// \brief bits packed into 64-bit words, least significant bit first; bits past `bits` are always zero
+  std::vector<uint64_t> elem;
   std::mutex mtx;
 
   bit_array() = default;
@@ -27,7 +29,7 @@ struct bit_array : public std::enable_shared_from_this<bit_array> {
   static std::shared_ptr<bit_array> new_bit_array(int bits_) {
     auto ret = std::make_shared<bit_array>();
     ret->bits = bits_;
-    ret->elem.resize(bits_);
+    ret->elem.resize(num_elems(bits_));
     return ret;
   }
 
@@ -35,7 +37,8 @@ struct bit_array : public std::enable_shared_from_this<bit_array> {
     if (other == nullptr) {
       return nullptr;
     }
-    return new_bit_array(other->bits);
+    std::scoped_lock g(other->mtx);
+    return other->copy();
   }
 
   int size() const {
@@ -50,9 +53,9 @@ struct bit_array : public std::enable_shared_from_this<bit_array> {
       return false;
     }
     std::scoped_lock g(mtx);
-    if (i >= bits)
+    if (i < 0 || i >= bits)
       return false;
-    return elem[i];
+    return (elem[i / 64] >> (i % 64)) & 1;
   }
 
   bool set_index(int i, bool v) {
@@ -60,9 +63,12 @@ struct bit_array : public std::enable_shared_from_this<bit_array> {
       return false;
     }
     std::scoped_lock g(mtx);
-    if (i >= bits)
+    if (i < 0 || i >= bits)
       return false;
-    elem[i] = v;
+    if (v)
+      elem[i / 64] |= uint64_t(1) << (i % 64);
+    else
+      elem[i / 64] &= ~(uint64_t(1) << (i % 64));
     return true;
   }
 
@@ -70,7 +76,9 @@ struct bit_array : public std::enable_shared_from_this<bit_array> {
     if (this == nullptr || o == nullptr)
       return nullptr;
     std::scoped_lock<std::mutex, std::mutex> g(mtx, o->mtx);
-    elem = o->elem;
+    auto smaller = std::min(elem.size(), o->elem.size());
+    std::copy(o->elem.begin(), o->elem.begin() + smaller, elem.begin());
+    clear_tail();
     return shared_from_this();
   }
 
@@ -80,9 +88,9 @@ struct bit_array : public std::enable_shared_from_this<bit_array> {
     std::scoped_lock<std::mutex, std::mutex> g(mtx, o->mtx);
     auto c = copy_bits(bits);
     auto smaller = std::min(elem.size(), o->elem.size());
-    for (auto i = 0; i < smaller; i++)
-      c->elem[i] = c->elem[i] & (~o->elem[i]); // and not
-    return c; // TODO: check if sub is correctly implemented
+    for (size_t i = 0; i < smaller; i++)
+      c->elem[i] &= ~o->elem[i]; // and not
+    return c;
   }
 
   /// \brief returns a bit_array resulting from a bitwise OR of two bit_arrays
@@ -96,8 +104,10 @@ struct bit_array : public std::enable_shared_from_this<bit_array> {
     std::scoped_lock<std::mutex, std::mutex> g(mtx, o->mtx);
     auto c = copy_bits(std::max(bits, o->bits));
     auto smaller = std::min(elem.size(), o->elem.size());
-    for (auto i = 0; i < smaller; i++)
-      c->elem[i] = c->elem[i] | (o->elem[i]); // or
+    for (size_t i = 0; i < smaller; i++)
+      c->elem[i] |= o->elem[i]; // or
+    if (o->elem.size() > smaller)
+      std::copy(o->elem.begin() + smaller, o->elem.end(), c->elem.begin() + smaller);
     return c;
   }
 
@@ -106,8 +116,9 @@ struct bit_array : public std::enable_shared_from_this<bit_array> {
       return nullptr;
     std::scoped_lock g(mtx);
     auto c = copy();
-    for (auto&& e : c->elem)
-      e = !e;
+    for (auto& e : c->elem)
+      e = ~e;
+    c->clear_tail();
     return c;
   }
 
@@ -120,44 +131,32 @@ struct bit_array : public std::enable_shared_from_this<bit_array> {
     return copy;
   }
 
+  /// \brief returns a copy resized to `bits_`, truncating or zero-extending
   std::shared_ptr<bit_array> copy_bits(int bits_) const {
-    auto ret = std::make_shared<bit_array>();
-    ret->bits = bits_;
-    ret->elem.resize(bits_);
-    std::copy(elem.begin(), elem.begin() + bits_, ret->elem.begin());
+    auto ret = new_bit_array(bits_);
+    auto smaller = std::min(elem.size(), ret->elem.size());
+    std::copy(elem.begin(), elem.begin() + smaller, ret->elem.begin());
+    ret->clear_tail();
     return ret;
   }
 
-  int num_elems(const int bits_) const {
+  static int num_elems(const int bits_) {
     return (bits_ + 63) / 64;
   }
 
   std::string string() const {
     std::string ret{};
-    for (auto e : elem) {
-      if (e)
-        ret.append("x");
-      else
-        ret.append("_");
-    }
+    ret.reserve(bits);
+    for (auto i = 0; i < bits; i++)
+      ret.push_back((elem[i / 64] >> (i % 64)) & 1 ? 'x' : '_');
     return ret;
   }
 
   Bytes get_bytes() const {
     auto num_bytes = (bits + 7) / 8;
-    Bytes bs;
-    bs.raw().reserve(num_bytes);
-    for (auto i = 0; i < bits; i += 8) {
-      uint8_t byte_{};
-      for (auto j = 0; j < 8 && (j + i) < bits; j++) {
-        if (elem[j + i]) {
-          byte_ |= 1 << j;
-        } else {
-          byte_ &= ~(1 << j);
-        }
-      }
-      bs.raw().push_back(static_cast<unsigned char>(byte_));
-    }
+    Bytes bs(num_bytes);
+    for (auto i = 0; i < num_bytes; i++)
+      bs[i] = static_cast<unsigned char>(elem[i / 8] >> ((i % 8) * 8));
     return bs;
   }
 
@@ -166,20 +165,34 @@ struct bit_array : public std::enable_shared_from_this<bit_array> {
     if (this == nullptr || elem.empty())
       return {0, false};
     std::scoped_lock g(mtx);
-    auto true_indices = get_true_indices();
-    if (true_indices.empty())
+    uint64_t count{0};
+    for (auto e : elem)
+      count += std::popcount(e);
+    if (count == 0)
       return {0, false};
-    std::vector<int> result;
-    std::sample(
-      true_indices.begin(), true_indices.end(), std::back_inserter(result), 1, std::mt19937{std::random_device{}()});
-    return {result[0], true};
+
+    thread_local std::mt19937_64 rng{std::random_device{}()};
+    auto nth = std::uniform_int_distribution<uint64_t>(0, count - 1)(rng);
+    for (size_t i = 0; i < elem.size(); i++) {
+      uint64_t ones = std::popcount(elem[i]);
+      if (nth >= ones) {
+        nth -= ones;
+        continue;
+      }
+      // select the nth set bit of the word
+      auto e = elem[i];
+      for (; nth > 0; nth--)
+        e &= e - 1;
+      return {static_cast<int>(i * 64 + std::countr_zero(e)), true};
+    }
+    return {0, false};
   }
 
   std::vector<int> get_true_indices() {
     std::vector<int> ret;
-    for (auto i = 0; i < elem.size(); i++) {
-      if (elem[i])
-        ret.push_back(i);
+    for (size_t i = 0; i < elem.size(); i++) {
+      for (auto e = elem[i]; e != 0; e &= e - 1)
+        ret.push_back(static_cast<int>(i * 64 + std::countr_zero(e)));
     }
     return ret;
   }
@@ -196,58 +209,38 @@ struct bit_array : public std::enable_shared_from_this<bit_array> {
   inline friend T& operator>>(T& ds, bit_array& v) {
     ds >> v.bits;
     auto num_bytes = (v.bits + 7) / 8;
-    v.elem.resize(v.bits);
     Bytes bs(num_bytes);
     ds >> bs;
-    int i{0};
-    for (const auto& byte_ : bs) {
-      for (auto j = 0; j < 8; j++) {
-        if ((byte_ >> j) & 1)
-          v.set_index(i, true);
-        else
-          v.set_index(i, false);
-        i++;
-      }
-    }
+    v.elem.assign(num_elems(v.bits), 0);
+    for (auto i = 0; i < bs.size() && i / 8 < v.elem.size(); i++)
+      v.elem[i / 8] |= uint64_t(bs[i]) << ((i % 8) * 8);
+    v.clear_tail();
     return ds;
   }
 
   static std::unique_ptr<::tendermint::libs::bits::BitArray> to_proto(const bit_array& b) {
     auto ret = std::make_unique<::tendermint::libs::bits::BitArray>();
     ret->set_bits(b.bits);
-
-    size_t elems_size = b.num_elems(b.bits);
-    std::vector<uint64_t> elems(elems_size);
-    auto bz = b.get_bytes();
-    int bz_i{0};
-    for (auto& elem : elems) {
-      elem = 0;
-      for (auto i = 0; i < 8 && bz_i < bz.size(); i++, bz_i++)
-        elem |= (uint64_t)bz[bz_i] << (i * 8);
-    }
-
     auto pb_elem = ret->mutable_elems();
-    for (const auto& e : elems)
-      pb_elem->Add(e);
+    pb_elem->Reserve(b.elem.size());
+    for (const auto& e : b.elem)
+      pb_elem->AddAlreadyReserved(e);
     return ret;
   }
 
   static std::shared_ptr<bit_array> from_proto(const ::tendermint::libs::bits::BitArray& pb) {
-    auto ret = std::make_shared<bit_array>();
-    ret->bits = pb.bits();
-    ret->elem.resize(ret->bits);
-    int i{0};
-    for (auto e : pb.elems()) {
-      for (auto j = 0; j < 64; j++) {
-        if ((e >> j) & 1)
-          ret->set_index(i, true);
-        else
-          ret->set_index(i, false);
-        i++;
-      }
-    }
+    auto ret = new_bit_array(static_cast<int>(std::max<int64_t>(pb.bits(), 0)));
+    auto smaller = std::min<size_t>(ret->elem.size(), pb.elems_size());
+    std::copy(pb.elems().begin(), pb.elems().begin() + smaller, ret->elem.begin());
+    ret->clear_tail();
     return ret;
   }
+
+private:
+  void clear_tail() {
+    if (auto rem = bits % 64; rem != 0 && !elem.empty())
+      elem.back() &= (uint64_t(1) << rem) - 1;
+  }
 };
 
 } // namespace noir::consensus
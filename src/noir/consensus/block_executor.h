@@ -4,6 +4,7 @@
 // SPDX-License-Identifier: AGPL-3.0-or-later
 //
 #pragma once
+#include <noir/common/thread_pool.h>
 #include <noir/consensus/abci_types.h>
 #include <noir/consensus/app_connection.h>
 #include <noir/consensus/common.h>
@@ -39,6 +40,14 @@ struct block_executor {
 
   std::map<std::string, bool> cache; // storing verification result for a single height
 
+  /// speculative execution of a complete proposal block, started before the block is committed
+  struct optimistic_execution {
+    Bytes block_hash;
+    std::future<std::shared_ptr<tendermint::state::ABCIResponses>> abci_responses;
+  };
+  std::optional<optimistic_execution> optimistic_exec;
+  std::optional<named_thread_pool> optimistic_thread_pool;
+
   block_executor(std::shared_ptr<db_store> new_store,
     std::shared_ptr<app_connection> new_proxyApp,
     std::shared_ptr<ev::evidence_pool> new_ev_pool,
@@ -64,19 +73,29 @@ struct block_executor {
     const std::shared_ptr<commit>& commit_,
     Bytes& proposer_addr,
     const std::vector<std::shared_ptr<vote>>& votes) {
+    auto [evidence, ev_size] = ev_pool->pending_evidence(state_.consensus_params_.evidence.max_bytes);
+    return make_proposal_block(height, state_, commit_, proposer_addr, std::move(evidence), ev_size);
+  }
+
+  /// \brief builds a proposal block from evidence already taken from the pool
+  /// \note uses nothing but its arguments, so it can run off the consensus thread on a copy of state
+  static std::tuple<std::shared_ptr<block>, std::shared_ptr<part_set>> make_proposal_block(int64_t height,
+    state& state_,
+    const std::shared_ptr<commit>& commit_,
+    const Bytes& proposer_addr,
+    std::vector<std::shared_ptr<evidence>> evidence_,
+    int64_t ev_size) {
     auto max_bytes = state_.consensus_params_.block.max_bytes;
     auto max_gas = state_.consensus_params_.block.max_gas;
 
-    auto [evidence, ev_size] = ev_pool->pending_evidence(state_.consensus_params_.evidence.max_bytes);
-
     // Fetch a limited amount of valid txs
     auto max_data_bytes_ = max_data_bytes(max_bytes, ev_size, state_.validators->size());
 
     // TODO : retrieve txs from mempool
     std::vector<Bytes> txs;
 
-    return state_.make_block(
-      height, txs, commit_, std::make_shared<evidence_list>(evidence_list{.list = evidence}), proposer_addr);
+    auto evs = std::make_shared<evidence_list>(evidence_list{.list = std::move(evidence_)});
+    return state_.make_block(height, txs, commit_, evs, proposer_addr);
   }
 
   bool validate_block(state& state_, const std::shared_ptr<block>& block_) {
@@ -156,11 +175,53 @@ struct block_executor {
         return false;
       }
     }
-
     cache[hex::encode(hash)] = true;
     return true;
   }
 
+  /// \brief starts executing a block on the application ahead of its commit
+  ///
+  /// apply_block() reuses the responses if the same block is committed. Otherwise the application state is rolled back
+  /// by discard_optimistic_execution(), so this is only done for applications supporting rollback.
+  /// This is called under the consensus lock. The block is validated here, as validation reads the evidence pool, and
+  /// the result is cached for the prevote. Only rolling back a previous execution and executing the block are posted to
+  /// the exec thread, one execution after another.
+  /// \param[in] state_ state the block is built on
+  /// \param[in] block_ complete proposal block
+  /// \return true if the block is being executed
+  bool exec_block_optimistically(state& state_, const std::shared_ptr<block>& block_) {
+    auto hash = block_->get_hash();
+    if (optimistic_exec && optimistic_exec->block_hash == hash)
+      return true;
+    if (!proxyApp_->supports_rollback())
+      return false;
+    if (!validate_block(state_, block_))
+      return false;
+
+    if (!optimistic_thread_pool)
+      optimistic_thread_pool.emplace("exec", 1);
+    dlog(fmt::format("executing block optimistically: height={}", block_->header.height));
+    // the previous execution is done by the time this one starts, so waiting for this one covers both
+    auto exec = [this, block_, initial_height = state_.initial_height, rollback = optimistic_exec.has_value()]() {
+      if (rollback && !proxyApp_->rollback_sync())
+        elog("failed to roll back optimistic execution");
+      return exec_block_on_proxy_app(proxyApp_, block_, store_, initial_height);
+    };
+    optimistic_exec = optimistic_execution{hash, async_thread_pool(optimistic_thread_pool->get_executor(), exec)};
+    return true;
+  }
+
+  /// \brief waits for the optimistic execution in progress, if any, and rolls back its changes to the application
+  void discard_optimistic_execution() {
+    if (!optimistic_exec)
+      return;
+    if (optimistic_exec->abci_responses.valid())
+      optimistic_exec->abci_responses.wait();
+    optimistic_exec.reset();
+    if (!proxyApp_->rollback_sync())
+      elog("failed to roll back optimistic execution");
+  }
+
   std::optional<state> apply_block(state& state_, p2p::block_id block_id_, std::shared_ptr<block> block_) {
     if (!validate_block(state_, block_)) {
       elog("apply block failed: invalid block");
@@ -168,7 +229,15 @@ struct block_executor {
     }
 
     auto start_time = get_time();
-    auto abci_responses_ = exec_block_on_proxy_app(proxyApp_, block_, store_, state_.initial_height);
+    std::shared_ptr<tendermint::state::ABCIResponses> abci_responses_;
+    if (optimistic_exec && optimistic_exec->block_hash == block_->get_hash())
+      abci_responses_ = optimistic_exec->abci_responses.get();
+    if (abci_responses_) {
+      optimistic_exec.reset();
+    } else {
+      discard_optimistic_execution();
+      abci_responses_ = exec_block_on_proxy_app(proxyApp_, block_, store_, state_.initial_height);
+    }
     auto end_time = get_time();
     if (abci_responses_ == nullptr) {
       elog("apply block failed: proxy app");
@@ -328,12 +397,12 @@ struct block_executor {
         check(false, fmt::format("panic: unable to load validator for height={}", block_->header.height - 1));
       // Check if commit_size matches validator_set size
       auto commit_size = block_->last_commit->size();
-      auto val_set_len = last_val_set->validators.size();
+      auto val_set_len = last_val_set->size();
       if (commit_size != val_set_len)
         check(false, "panic: commit_size doesn't match val_set length");
-      for (auto i = 0; i < last_val_set->validators.size(); i++) {
+      for (auto i = 0; i < last_val_set->size(); i++) {
         tendermint::abci::VoteInfo v;
-        *v.mutable_validator() = tm2pb::to_validator(std::make_shared<validator>(last_val_set->validators[i]));
+        *v.mutable_validator() = tm2pb::to_validator(std::make_shared<validator>(*last_val_set->get_by_index(i)));
         auto commit_sig = block_->last_commit->signatures[i];
         v.set_signed_last_block(!commit_sig.absent());
         vote_infos[i] = v;
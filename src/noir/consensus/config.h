@@ -85,6 +85,18 @@ struct consensus_config {
 
   int64_t double_sign_check_height;
 
+  bool wal_group_commit; ///< share a single fsync among concurrent WAL syncs
+  bool wal_async_writer; ///< append WAL frames on a dedicated writer thread; takes precedence over wal_group_commit
+
+  bool optimistic_execution; ///< execute a complete proposal block before it is committed; needs app rollback support
+
+  /// derive propose, prevote and precommit timeouts from latencies observed in recent heights
+  bool adaptive_timeouts;
+  std::chrono::system_clock::duration timeout_adaptive_min; ///< lower bound of an adaptive timeout at round 0
+  std::chrono::system_clock::duration timeout_adaptive_max; ///< upper bound of an adaptive timeout at round 0
+  std::chrono::system_clock::duration timeout_adaptive_margin; ///< added to the observed percentile
+  uint32_t timeout_adaptive_percentile; ///< percentile of observed latencies to wait for, in [1, 100]
+
   static consensus_config get_default() {
     consensus_config cfg;
     cfg.wal_path = std::string(default_data_dir) + "/" + "cs.wal";
@@ -101,6 +113,14 @@ struct consensus_config {
     cfg.peer_gossip_sleep_duration = std::chrono::milliseconds{100};
     cfg.peer_query_maj_23_sleep_duration = std::chrono::milliseconds{2000};
     cfg.double_sign_check_height = 0;
+    cfg.wal_group_commit = true;
+    cfg.wal_async_writer = false;
+    cfg.optimistic_execution = false;
+    cfg.adaptive_timeouts = false;
+    cfg.timeout_adaptive_min = std::chrono::milliseconds{200};
+    cfg.timeout_adaptive_max = std::chrono::milliseconds{3000};
+    cfg.timeout_adaptive_margin = std::chrono::milliseconds{100};
+    cfg.timeout_adaptive_percentile = 99;
     return cfg;
   }
 
@@ -185,5 +205,6 @@ NOIR_REFLECT(noir::consensus::base_config, chain_id, root_dir, proxy_app, monike
 NOIR_REFLECT(noir::consensus::consensus_config, root_dir, wal_path, wal_file, timeout_propose, timeout_propose_delta,
   timeout_prevote, timeout_prevote_delta, timeout_precommit, timeout_precommit_delta, timeout_commit,
   skip_timeout_commit, create_empty_blocks, create_empty_blocks_interval, peer_gossip_sleep_duration,
-  peer_query_maj_23_sleep_duration, double_sign_check_height);
+  peer_query_maj_23_sleep_duration, double_sign_check_height, wal_group_commit, wal_async_writer, optimistic_execution,
+  adaptive_timeouts, timeout_adaptive_min, timeout_adaptive_max, timeout_adaptive_margin, timeout_adaptive_percentile);
 NOIR_REFLECT(noir::consensus::config, base, consensus, priv_validator);
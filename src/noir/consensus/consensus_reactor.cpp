@@ -39,7 +39,16 @@ void consensus_reactor::process_peer_update(plugin_interface::peer_status_info_p
     auto it = peers.find(info->peer_id);
     if (it != peers.end() && it->second->is_running) {
       it->second->is_running = false;
+      // let parked routines observe is_running right away
+      it->second->strand->post([ps = it->second]() {
+        ps->data_timer->wake();
+        ps->votes_timer->wake();
+        ps->query_maj23_timer->wake();
+      });
       peers.erase(it);
+      // tasks already queued keep the strand alive
+      std::scoped_lock g_verify(verify_mtx);
+      verify_strands.erase(info->peer_id);
     }
     break;
   }
@@ -104,10 +113,9 @@ void consensus_reactor::process_peer_msg(p2p::envelope_ptr info) {
       [&ps](p2p::new_valid_block_message& msg) { ps->apply_new_valid_block_message(msg); },
       [&ps](p2p::has_vote_message& msg) { ps->apply_has_vote_message(msg); },
       [this, &ps, &from](p2p::vote_set_maj23_message& msg) {
-        std::unique_lock<std::mutex> lock(cs_state->mtx);
-        auto height = cs_state->rs.height;
-        auto votes = cs_state->rs.votes;
-        lock.unlock();
+        auto rs = cs_state->get_round_state();
+        auto height = rs->height;
+        auto votes = rs->votes;
         if (height != msg.height)
           return;
 
@@ -143,32 +151,66 @@ void consensus_reactor::process_peer_msg(p2p::envelope_ptr info) {
       [&ps](p2p::proposal_pol_message& msg) { ps->apply_proposal_pol_message(msg); },
       [this, &ps, &from](p2p::block_part_message& msg) {
         ps->set_has_proposal_block_part(msg.height, msg.round, msg.index);
-        internal_mq_channel.publish(
-          appbase::priority::medium, std::make_shared<p2p::internal_msg_info>(p2p::internal_msg_info{msg, from}));
+        auto rs = cs_state->get_round_state();
+        Bytes root{};
+        if (rs->height == msg.height && rs->proposal_block_parts)
+          root = rs->proposal_block_parts->hash;
+        auto same_round = rs->round == msg.round;
+
+        // Merkle proofs are checked on worker threads as signatures of votes are; consensus_state then only inserts
+        // parts already checked against the root of its part set.
+        post_verify(from, [this, from, msg, root{std::move(root)}, same_round]() {
+          auto mi = std::make_shared<p2p::internal_msg_info>(p2p::internal_msg_info{msg, from});
+          if (!root.empty()) {
+            if (!msg.proof.verify(root, msg.bytes_).has_value()) {
+              mi->verified_part_root = root;
+            } else if (same_round) {
+              wlog(fmt::format("dropped block part with invalid proof: from={} height={} round={} index={}", from,
+                msg.height, msg.round, msg.index));
+              return;
+            }
+            // otherwise the part may belong to a part set newer than our snapshot, so leave it to consensus_state
+          }
+          internal_mq_channel.publish(appbase::priority::medium, mi);
+        });
       },
       /***************************************************************************************************/
       ///< vote message: vote
       [this, &ps, &from](p2p::vote_message& msg) {
-        std::unique_lock<std::mutex> lock(cs_state->mtx);
-        auto height = cs_state->rs.height;
-        auto val_size = cs_state->rs.validators->size();
-        auto last_commit_size = cs_state->rs.last_commit->get_size();
-        lock.unlock();
-
-        ps->ensure_vote_bit_arrays(height, val_size);
-        ps->ensure_vote_bit_arrays(height - 1, last_commit_size);
-        ps->set_has_vote(msg);
-
-        internal_mq_channel.publish(
-          appbase::priority::medium, std::make_shared<p2p::internal_msg_info>(p2p::internal_msg_info{msg, from}));
+        auto rs = cs_state->get_round_state();
+        auto height = rs->height;
+        auto validators = rs->validators;
+        auto last_validators = rs->last_validators;
+        auto last_commit_size = rs->last_commit->get_size();
+
+        // Signatures are checked on worker threads so that votes from different peers are verified in parallel;
+        // a valid signature is added to the signature cache, so consensus_state's own check of it is a cache hit.
+        post_verify(from,
+          [this, ps, from, msg, height, validators{std::move(validators)}, last_validators{std::move(last_validators)},
+            last_commit_size]() mutable {
+            auto& vals = msg.height == height ? validators : last_validators;
+            if (msg.height == height || msg.height + 1 == height) {
+              if (!pre_verify_vote(msg, vals, chain_id)) {
+                wlog(fmt::format("dropped vote with invalid signature: from={} height={} index={}", from, msg.height,
+                  msg.validator_index));
+                return;
+              }
+            }
+
+            ps->ensure_vote_bit_arrays(height, validators->size());
+            ps->ensure_vote_bit_arrays(height - 1, last_commit_size);
+            ps->set_has_vote(msg);
+
+            internal_mq_channel.publish(
+              appbase::priority::medium, std::make_shared<p2p::internal_msg_info>(p2p::internal_msg_info{msg, from}));
+          });
       },
       /***************************************************************************************************/
       ///< vote_set_bits message: vote_set_bits
       [this, &ps](p2p::vote_set_bits_message& msg) {
-        std::unique_lock<std::mutex> lock(cs_state->mtx);
-        auto height = cs_state->rs.height;
-        auto votes = cs_state->rs.votes;
-        lock.unlock();
+        auto rs = cs_state->get_round_state();
+        auto height = rs->height;
+        auto votes = rs->votes;
 
         if (height == msg.height) {
           std::shared_ptr<bit_array> our_votes{};
@@ -188,6 +230,9 @@ void consensus_reactor::process_peer_msg(p2p::envelope_ptr info) {
         }
       }},
     cs_msg);
+
+  // The round state of the peer may have changed
+  wake_gossip(ps);
 }
 
 p2p::cs_reactor_message consensus_reactor::process_state_ch(const Bytes& msg) {
@@ -268,6 +313,43 @@ p2p::cs_reactor_message consensus_reactor::process_vote_ch(const Bytes& msg) {
   }
   return {};
 }
+bool consensus_reactor::pre_verify_vote(
+  const p2p::vote_message& msg, const std::shared_ptr<validator_set>& vals, const std::string& chain_id) {
+  if (!vals)
+    return true;
+  // Leave votes from unknown validators to vote_set::add_vote, which reports the exact reason
+  auto val = vals->get_by_index(msg.validator_index);
+  if (!val || val->address != msg.validator_address)
+    return true;
+  return vote{msg}.verify(chain_id, val->pub_key_);
+}
+
+void consensus_reactor::post_verify(const std::string& peer_id, std::function<void()> task) {
+  std::unique_lock g(verify_mtx);
+  if (verify_stopped)
+    return;
+  ++verify_pending;
+  auto it = verify_strands.find(peer_id);
+  if (it == verify_strands.end())
+    it = verify_strands.emplace(peer_id, boost::asio::make_strand(verifier_pool().get_executor())).first;
+  auto strand = it->second;
+  g.unlock();
+
+  boost::asio::post(strand, [this, task{std::move(task)}]() {
+    if (!verify_stopped)
+      task();
+    std::scoped_lock g(verify_mtx);
+    if (--verify_pending == 0)
+      verify_cv.notify_all();
+  });
+}
+
+void consensus_reactor::stop_verify() {
+  std::unique_lock g(verify_mtx);
+  verify_stopped = true;
+  verify_cv.wait(g, [this]() { return verify_pending == 0; });
+}
+
 p2p::cs_reactor_message consensus_reactor::process_vote_set_bits_ch(const Bytes& msg) {
   ::tendermint::consensus::Message pb_msg;
   pb_msg.ParseFromArray(msg.data(), msg.size());
@@ -320,19 +402,20 @@ void consensus_reactor::gossip_data_routine(std::shared_ptr<peer_state> ps) {
         block_meta block_meta_;
         if (!cs_state->block_store_->load_block_meta(prs->height, block_meta_)) {
           elog("failed to load block_meta");
-          std::this_thread::sleep_for(cs_state->cs_config.peer_gossip_sleep_duration);
-        } else {
-          ps->init_proposal_block_parts(block_meta_.bl_id.parts);
+          wait_gossip_data(ps);
+          return;
         }
+        ps->init_proposal_block_parts(block_meta_.bl_id.parts);
+        gossip_data_routine(ps);
+      } else if (gossip_data_for_catchup(rs, prs, ps)) {
+        gossip_data_routine(ps);
       } else {
-        gossip_data_for_catchup(rs, prs, ps);
+        wait_gossip_data(ps);
       }
-      gossip_data_routine(ps);
 
     } else if (rs->height != prs->height || rs->round != prs->round) {
-      // If height and round don't match
-      std::this_thread::sleep_for(cs_state->cs_config.peer_gossip_sleep_duration);
-      gossip_data_routine(ps);
+      // If height and round don't match, wait until either of us moves
+      wait_gossip_data(ps);
 
     } else if (rs->proposal != nullptr && !prs->proposal) {
       /// By here, height and round should match.
@@ -353,14 +436,13 @@ void consensus_reactor::gossip_data_routine(std::shared_ptr<peer_state> ps) {
       gossip_data_routine(ps);
 
     } else {
-      // Nothing to do, so just sleep for a while
-      std::this_thread::sleep_for(cs_state->cs_config.peer_gossip_sleep_duration);
-      gossip_data_routine(ps);
+      // Nothing to do, so wait for a change of round state
+      wait_gossip_data(ps);
     }
   });
 }
 
-void consensus_reactor::gossip_data_for_catchup(const std::shared_ptr<round_state>& rs,
+bool consensus_reactor::gossip_data_for_catchup(const std::shared_ptr<const round_state>& rs,
   const std::shared_ptr<peer_round_state>& prs,
   const std::shared_ptr<peer_state>& ps) {
   if (auto [index, ok] = prs->proposal_block_parts->not_op()->pick_random(); ok) {
@@ -368,27 +450,25 @@ void consensus_reactor::gossip_data_for_catchup(const std::shared_ptr<round_stat
     block_meta block_meta_;
     if (!cs_state->block_store_->load_block_meta(prs->height, block_meta_)) {
       elog("failed to load block_meta");
-      std::this_thread::sleep_for(cs_state->cs_config.peer_gossip_sleep_duration);
-      return;
+      return false;
     } else if (block_meta_.bl_id.parts != prs->proposal_block_part_set_header) {
       ilog("peer proposal_block_part_set_header mismatch");
-      std::this_thread::sleep_for(cs_state->cs_config.peer_gossip_sleep_duration);
-      return;
+      return false;
     }
 
     part part_;
     if (!cs_state->block_store_->load_block_part(prs->height, index, part_)) {
       elog("failed to load block_part");
-      std::this_thread::sleep_for(cs_state->cs_config.peer_gossip_sleep_duration);
-      return;
+      return false;
     }
 
     dlog("sending block_part for catchup");
     transmit_new_envelope(
       "", ps->peer_id, p2p::block_part_message{prs->height, prs->round, part_.index, part_.bytes_, part_.proof_});
-    return;
+    ps->set_has_proposal_block_part(prs->height, prs->round, index);
+    return true;
   }
-  std::this_thread::sleep_for(cs_state->cs_config.peer_gossip_sleep_duration);
+  return false;
 }
 
 void consensus_reactor::gossip_votes_routine(std::shared_ptr<peer_state> ps) {
@@ -421,14 +501,13 @@ void consensus_reactor::gossip_votes_routine(std::shared_ptr<peer_state> ps) {
       gossip_votes_routine(ps);
 
     } else {
-      // Nothing to do, so just sleep for a while
-      std::this_thread::sleep_for(cs_state->cs_config.peer_gossip_sleep_duration);
-      gossip_votes_routine(ps);
+      // Nothing to do, so wait for a change of round state
+      wait_gossip_votes(ps);
     }
   });
 }
 
-bool consensus_reactor::gossip_votes_for_height(const std::shared_ptr<round_state>& rs,
+bool consensus_reactor::gossip_votes_for_height(const std::shared_ptr<const round_state>& rs,
   const std::shared_ptr<peer_round_state>& prs,
   const std::shared_ptr<peer_state>& ps) {
   // If there are last_commits to send
@@ -499,7 +578,7 @@ bool consensus_reactor::pick_send_vote(const std::shared_ptr<peer_state>& ps, co
 
 /// \brief detect and react when there is a signature DDoS attack in progress
 void consensus_reactor::query_maj23_routine(std::shared_ptr<peer_state> ps) {
-  thread_pool_query_maj23->get_executor().post([this, ps{std::move(ps)}]() {
+  ps->strand->post([this, ps{std::move(ps)}]() {
     if (!ps->is_running)
       return;
 
@@ -511,7 +590,6 @@ void consensus_reactor::query_maj23_routine(std::shared_ptr<peer_state> ps) {
         if (auto maj23 = rs->votes->prevotes(prs->round)->two_thirds_majority(); maj23.has_value()) {
           transmit_new_envelope(
             "", ps->peer_id, p2p::vote_set_maj23_message{prs->height, prs->round, p2p::Prevote, maj23.value()});
-          std::this_thread::sleep_for(cs_state->cs_config.peer_query_maj_23_sleep_duration);
         }
       }
     }
@@ -524,7 +602,6 @@ void consensus_reactor::query_maj23_routine(std::shared_ptr<peer_state> ps) {
         if (auto maj23 = rs->votes->precommits(prs->round)->two_thirds_majority(); maj23.has_value()) {
           transmit_new_envelope(
             "", ps->peer_id, p2p::vote_set_maj23_message{prs->height, prs->round, p2p::Precommit, maj23.value()});
-          std::this_thread::sleep_for(cs_state->cs_config.peer_query_maj_23_sleep_duration);
         }
       }
     }
@@ -537,7 +614,6 @@ void consensus_reactor::query_maj23_routine(std::shared_ptr<peer_state> ps) {
         if (auto maj23 = rs->votes->prevotes(prs->proposal_pol_round)->two_thirds_majority(); maj23.has_value()) {
           transmit_new_envelope("", ps->peer_id,
             p2p::vote_set_maj23_message{prs->height, prs->proposal_pol_round, p2p::Prevote, maj23.value()});
-          std::this_thread::sleep_for(cs_state->cs_config.peer_query_maj_23_sleep_duration);
         }
       }
     }
@@ -550,16 +626,42 @@ void consensus_reactor::query_maj23_routine(std::shared_ptr<peer_state> ps) {
         if (auto commit_ = cs_state->load_commit(prs->height); commit_ != nullptr) {
           transmit_new_envelope("", ps->peer_id,
             p2p::vote_set_maj23_message{prs->height, commit_->round, p2p::Precommit, commit_->my_block_id});
-          std::this_thread::sleep_for(cs_state->cs_config.peer_query_maj_23_sleep_duration);
         }
       }
     }
 
-    std::this_thread::sleep_for(cs_state->cs_config.peer_query_maj_23_sleep_duration);
-    query_maj23_routine(ps);
+    // Queries are periodic; this timer is only woken up when the peer goes down
+    ps->query_maj23_timer->wait(
+      cs_state->cs_config.peer_query_maj_23_sleep_duration, [this, ps]() { query_maj23_routine(ps); });
+  });
+}
+
+void consensus_reactor::wait_gossip_data(const std::shared_ptr<peer_state>& ps) {
+  ps->data_timer->wait(cs_state->cs_config.peer_gossip_sleep_duration, [this, ps]() { gossip_data_routine(ps); });
+}
+
+void consensus_reactor::wait_gossip_votes(const std::shared_ptr<peer_state>& ps) {
+  ps->votes_timer->wait(cs_state->cs_config.peer_gossip_sleep_duration, [this, ps]() { gossip_votes_routine(ps); });
+}
+
+void consensus_reactor::wake_gossip(const std::shared_ptr<peer_state>& ps) {
+  // coalesce bursts of events into a single wake-up per peer
+  if (ps->wake_pending.exchange(true, std::memory_order_acq_rel))
+    return;
+  ps->strand->post([ps]() {
+    // cleared before waking so that an event arriving meanwhile queues another wake-up
+    ps->wake_pending.store(false, std::memory_order_release);
+    ps->data_timer->wake();
+    ps->votes_timer->wake();
   });
 }
 
+void consensus_reactor::wake_gossip_all() {
+  std::scoped_lock g(mtx);
+  for (const auto& [_, ps] : peers)
+    wake_gossip(ps);
+}
+
 void consensus_reactor::send_new_round_step_message(std::string peer_id) {
   auto rs = cs_state->get_round_state();
   auto msg = make_round_step_message(*rs);
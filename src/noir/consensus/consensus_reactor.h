@@ -11,6 +11,9 @@
 #include <noir/consensus/store/store_test.h>
 #include <noir/consensus/types/event_bus.h>
 #include <noir/consensus/types/events.h>
+#include <boost/asio/strand.hpp>
+#include <condition_variable>
+#include <thread>
 
 namespace noir::consensus {
 
@@ -28,7 +31,17 @@ struct consensus_reactor {
 
   uint16_t thread_pool_size = 5;
   std::optional<named_thread_pool> thread_pool_gossip;
-  std::optional<named_thread_pool> thread_pool_query_maj23;
+
+  // tasks posted to verifier_pool() which have not finished yet; the pool is shared, so on_stop() waits for them
+  std::mutex verify_mtx;
+  std::condition_variable verify_cv;
+  size_t verify_pending = 0;
+  std::atomic<bool> verify_stopped = false;
+  // messages of a peer are verified one at a time, so that consensus_state receives them in the order they arrived
+  std::map<std::string, boost::asio::strand<boost::asio::io_context::executor_type>> verify_strands;
+
+  // chain id votes are verified against; it never changes, so it is read once instead of under cs_state->mtx
+  std::string chain_id;
 
   // Receive an event from consensus_state
   plugin_interface::egress::channels::event_switch_message_queue::channel_type::handle event_switch_mq_subscription =
@@ -61,8 +74,8 @@ struct consensus_reactor {
       event_bus_(event_bus_),
       wait_sync(new_wait_sync),
       xmt_mq_channel(app.get_channel<plugin_interface::egress::channels::transmit_message_queue>()) {
+    chain_id = cs_state->get_state().chain_id;
     thread_pool_gossip.emplace("gossip", thread_pool_size);
-    thread_pool_query_maj23.emplace("query_maj23", thread_pool_size);
   }
 
   static std::shared_ptr<consensus_reactor> new_consensus_reactor(appbase::application& app,
@@ -85,7 +98,7 @@ struct consensus_reactor {
         peer.second->is_running = false;
     }
     thread_pool_gossip->stop();
-    thread_pool_query_maj23->stop();
+    stop_verify();
     cs_state->on_stop();
     ilog("stopped cs_reactor");
   }
@@ -122,7 +135,11 @@ struct consensus_reactor {
     case EventVote:
       broadcast_has_vote_message(std::get<p2p::vote_message>(info->message_));
       break;
+    default:
+      break;
     }
+    // Our round state has changed; there may be something new to send
+    wake_gossip_all();
   }
 
   void process_peer_update(plugin_interface::peer_status_info_ptr info);
@@ -133,15 +150,33 @@ struct consensus_reactor {
   p2p::cs_reactor_message process_vote_ch(const Bytes& msg);
   p2p::cs_reactor_message process_vote_set_bits_ch(const Bytes& msg);
 
+  /// \brief checks the signature of a vote received from a peer without holding the consensus mutex
+  /// A valid signature is recorded in signature_cache, so consensus_state does not verify it again.
+  /// \param[in] msg vote to check
+  /// \param[in] vals validator set for the height of the vote
+  /// \param[in] chain_id chain id the vote is signed for
+  /// \return false if the vote is known to be invalid
+  static bool pre_verify_vote(
+    const p2p::vote_message& msg, const std::shared_ptr<validator_set>& vals, const std::string& chain_id);
+
+  /// \brief runs a task on verifier_pool() after all tasks previously posted for the same peer
+  /// Tasks still queued when the reactor stops are dropped.
+  /// \param[in] peer_id peer the verified message came from
+  /// \param[in] task task to run
+  void post_verify(const std::string& peer_id, std::function<void()> task);
+
+  /// \brief drops queued verification tasks and waits for running ones to finish
+  void stop_verify();
+
   void gossip_data_routine(std::shared_ptr<peer_state> ps);
 
-  void gossip_data_for_catchup(const std::shared_ptr<round_state>& rs,
+  bool gossip_data_for_catchup(const std::shared_ptr<const round_state>& rs,
     const std::shared_ptr<peer_round_state>& prs,
     const std::shared_ptr<peer_state>& ps);
 
   void gossip_votes_routine(std::shared_ptr<peer_state> ps);
 
-  bool gossip_votes_for_height(const std::shared_ptr<round_state>& rs,
+  bool gossip_votes_for_height(const std::shared_ptr<const round_state>& rs,
     const std::shared_ptr<peer_round_state>& prs,
     const std::shared_ptr<peer_state>& ps);
 
@@ -149,6 +184,14 @@ struct consensus_reactor {
 
   void query_maj23_routine(std::shared_ptr<peer_state> ps);
 
+  /// \brief parks gossip routines of a peer until a round state changes or peer_gossip_sleep_duration passes
+  void wait_gossip_data(const std::shared_ptr<peer_state>& ps);
+  void wait_gossip_votes(const std::shared_ptr<peer_state>& ps);
+
+  /// \brief resumes parked gossip routines of a peer
+  void wake_gossip(const std::shared_ptr<peer_state>& ps);
+  void wake_gossip_all();
+
   std::shared_ptr<peer_state> get_peer_state(std::string peer_id) {
     std::scoped_lock g(mtx);
     auto it = peers.find(peer_id);
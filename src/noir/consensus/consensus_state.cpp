@@ -20,8 +20,10 @@ using p2p::round_step_type;
 
 struct message_handler {
   std::shared_ptr<consensus_state> cs;
+  Bytes verified_part_root;
 
-  explicit message_handler(std::shared_ptr<consensus_state> cs_): cs(std::move(cs_)) {}
+  message_handler(std::shared_ptr<consensus_state> cs_, Bytes verified_part_root_)
+    : cs(std::move(cs_)), verified_part_root(std::move(verified_part_root_)) {}
 
   void operator()(p2p::proposal_message& msg) {
     std::scoped_lock g(cs->mtx);
@@ -33,7 +35,8 @@ struct message_handler {
   void operator()(p2p::block_part_message& msg) {
     std::scoped_lock g(cs->mtx);
     // if the proposal is complete, we'll enter_prevote or try_finalize_commit
-    auto added = cs->add_proposal_block_part(msg, node_id{});
+    auto added = cs->add_proposal_block_part(msg, node_id{}, verified_part_root);
+    cs->publish_round_state();
     if (msg.round != cs->rs.round) {
       dlog(fmt::format("received block part from wrong round: height={} cs_round={} block_round={}", cs->rs.height,
         cs->rs.round, msg.round));
@@ -45,6 +48,7 @@ struct message_handler {
     // attempt to add the vote and dupeout the validator if its a duplicate signature
     // if the vote gives us a 2/3-any or 2/3-one, we transition
     cs->try_add_vote(msg, node_id{});
+    cs->publish_round_state();
   }
 };
 
@@ -65,6 +69,7 @@ consensus_state::consensus_state(appbase::application& app, const std::shared_pt
     timeout_ticker_timer.reset(new boost::asio::steady_timer(thread_pool->get_executor()));
   }
   old_ti = std::make_shared<timeout_info>(timeout_info{});
+  rs_snapshot = std::make_shared<const round_state>(rs);
 }
 
 std::shared_ptr<consensus_state> consensus_state::new_state(appbase::application& app,
@@ -104,11 +109,8 @@ int64_t consensus_state::get_last_height() {
   return rs.height - 1;
 }
 
-std::shared_ptr<round_state> consensus_state::get_round_state() {
-  std::scoped_lock g(mtx);
-  auto rs_copy = std::make_shared<round_state>();
-  *rs_copy = rs;
-  return rs_copy;
+std::shared_ptr<const round_state> consensus_state::get_round_state() {
+  return std::atomic_load(&rs_snapshot);
 }
 
 void consensus_state::set_priv_validator(const std::shared_ptr<priv_validator>& priv) {
@@ -203,7 +205,10 @@ bool consensus_state::load_wal_file() {
     } else {
       fs::create_directories(wal_file_path);
     }
-    wal_ = std::make_unique<base_wal>(wal_file_path.string(), wal_head_name, wal_file_num, wal_file_size);
+    auto mode = cs_config.wal_async_writer ? wal_sync_mode::async_writer
+      : cs_config.wal_group_commit         ? wal_sync_mode::group_commit
+                                           : wal_sync_mode::immediate;
+    wal_ = std::make_unique<base_wal>(wal_file_path.string(), wal_head_name, wal_file_num, wal_file_size, mode);
   } catch (...) {
     elog("failed to start wal");
     return false;
@@ -384,7 +389,25 @@ void consensus_state::update_to_state(state& state_) {
   new_step();
 }
 
+std::chrono::steady_clock::time_point consensus_state::meter_step() {
+  auto now = std::chrono::steady_clock::now();
+  if (step_start_time != std::chrono::steady_clock::time_point{})
+    metrics.observe(fmt::format("step.{}", round_step_to_str(metered_step)), now - step_start_time);
+  metered_step = rs.step;
+  step_start_time = now;
+  if (rs.step == round_step_type::NewHeight && rs.round == 0)
+    height_start_time = now;
+  if (rs.step == round_step_type::NewRound)
+    round_start_time = now;
+  return now;
+}
+
 void consensus_state::new_step() {
+  publish_round_state();
+
+  auto now = meter_step();
+  timeouts.enter_step(rs.height, rs.round, rs.step, now);
+
   auto event = events::event_data_round_state{rs};
   if (!wal_->write({event})) { // TODO: null check for rs or WAL?
     elog("failed writing to WAL");
@@ -398,6 +421,12 @@ void consensus_state::new_step() {
     std::make_shared<plugin_interface::event_info>(plugin_interface::event_info{EventNewRoundStep, round_state{rs}}));
 }
 
+// A snapshot copies only the scalar fields and pointers of rs, so votes, blocks and part sets are shared with the live
+// state. Readers keep using the snapshot they loaded while a newer one is swapped in.
+void consensus_state::publish_round_state() {
+  std::atomic_store(&rs_snapshot, std::make_shared<const round_state>(rs));
+}
+
 /**
  * receiveRoutine handles messages which may cause state transitions.
  * it's argument (n) is the number of messages to process before exiting - use 0 to run forever
@@ -406,8 +435,15 @@ void consensus_state::new_step() {
  * State must be locked before any internal state is updated.
  */
 void consensus_state::receive_routine(p2p::internal_msg_info_ptr mi) {
-  message_handler m(shared_from_this());
-  if (!wal_->write_sync({*mi})) { // TODO: sync is not needed for receive_message_queue
+  message_handler m(shared_from_this(), mi->verified_part_root);
+  if (!mi->peer_id.empty()) {
+    // peer messages need not be durable before they are processed; sign_vote and finalize_commit flush the WAL
+    // before anything depending on them leaves this node
+    if (!wal_->write({*mi})) {
+      elog("failed writing to WAL");
+    }
+  } else if (!timed("wal_sync", [&]() { return wal_->write_sync({*mi}); })) {
+    // our own messages are synced so that we never sign conflicting messages after a restart
     elog("failed writing to WAL");
   }
   std::visit(m, mi->msg);
@@ -527,6 +563,7 @@ void consensus_state::enter_new_round(int64_t height, int32_t round) {
   // we don't fire newStep for this step,
   // but we fire an event, so update the round step first
   update_round_step(round, round_step_type::NewRound);
+  meter_step();
   rs.validators = validators;
   if (round == 0) {
     // We've already reset these upon new height,
@@ -577,7 +614,7 @@ void consensus_state::enter_propose(int64_t height, int32_t round) {
   });
 
   // If we don't get the proposal and all block parts quick enough, enter_prevote
-  schedule_timeout(cs_config.propose(round), height, round, round_step_type::Propose);
+  schedule_timeout(timeouts.propose(cs_config, round), height, round, round_step_type::Propose);
 
   // Nothing more to do if we are not a validator
   if (!local_priv_validator) {
@@ -657,8 +694,12 @@ void consensus_state::decide_proposal(int64_t height, int32_t round) {
     }
     auto proposer_addr = local_priv_validator_pub_key.address();
 
-    std::tie(block_, block_parts_) =
-      block_exec->create_proposal_block(rs.height, local_state, commit_, proposer_addr, votes_);
+    if (auto prepared = take_prepared_proposal(); prepared.has_value()) {
+      std::tie(block_, block_parts_) = prepared.value();
+    } else {
+      std::tie(block_, block_parts_) =
+        block_exec->create_proposal_block(rs.height, local_state, commit_, proposer_addr, votes_);
+    }
 
     if (!block_) {
       wlog("MUST CONNECT TO MEMPOOL IN ORDER TO RETRIEVE SOME BLOCKS"); // todo - remove once mempool is ready
@@ -668,7 +709,7 @@ void consensus_state::decide_proposal(int64_t height, int32_t round) {
 
   // Flush the WAL. Otherwise, we may not recompute the same proposal to sign,
   // and the privValidator will refuse to sign anything.
-  if (!wal_->flush_and_sync()) {
+  if (!timed("wal_sync", [&]() { return wal_->flush_and_sync(); })) {
     elog("failed flushing WAL to disk");
   }
 
@@ -695,6 +736,73 @@ void consensus_state::decide_proposal(int64_t height, int32_t round) {
   }
 }
 
+// Building a block reaps txs and evidence, encodes the block and computes its part set, which would otherwise delay
+// the proposal at the start of round 0. The block depends on the last commit and pending evidence, so it is rebuilt
+// when a late precommit arrives and dropped if either has changed by the time it is proposed.
+void consensus_state::prepare_proposal() {
+  next_proposal.reset();
+  if (!local_priv_validator || local_priv_validator_pub_key.empty() || rs.valid_block)
+    return;
+  auto proposer_addr = local_priv_validator_pub_key.address();
+  if (!is_proposal(proposer_addr))
+    return;
+
+  std::shared_ptr<commit> commit_{};
+  int64_t last_commit_power{0};
+  if (rs.height == local_state.initial_height) {
+    std::vector<commit_sig> commit_sigs;
+    commit_ = commit::new_commit(0, 0, p2p::block_id{}, commit_sigs);
+  } else if (rs.last_commit->has_two_thirds_majority()) {
+    commit_ = rs.last_commit->make_commit();
+    last_commit_power = rs.last_commit->sum;
+  } else {
+    return;
+  }
+
+  // The build shares nothing with the consensus thread: validator sets are copied, as the state copy would otherwise
+  // still point to ours, and evidence is taken from the pool here. The version is read first, so evidence added in
+  // between makes the prepared block outdated rather than missing it.
+  auto evidence_version = block_exec->ev_pool ? block_exec->ev_pool->get_version() : 0;
+  auto state_ = local_state;
+  for (auto* vals : {&state_.validators, &state_.next_validators, &state_.last_validators}) {
+    if (*vals)
+      *vals = (*vals)->copy();
+  }
+  auto [evidence_, ev_size] = block_exec->ev_pool->pending_evidence(state_.consensus_params_.evidence.max_bytes);
+
+  if (!proposal_thread_pool)
+    proposal_thread_pool.emplace("prop", 1);
+  dlog(fmt::format("preparing proposal block: height={}", rs.height));
+  auto build = [height = rs.height, state_ = std::move(state_), commit_, proposer_addr,
+                 evidence_ = std::move(evidence_), ev_size = ev_size]() mutable {
+    auto ret =
+      block_executor::make_proposal_block(height, state_, commit_, proposer_addr, std::move(evidence_), ev_size);
+    if (auto& block_ = std::get<0>(ret); block_)
+      block_->get_hash();
+    return ret;
+  };
+  next_proposal = prepared_proposal{rs.height, last_commit_power, evidence_version,
+    async_thread_pool(proposal_thread_pool->get_executor(), std::move(build))};
+}
+
+std::optional<std::tuple<std::shared_ptr<block>, std::shared_ptr<part_set>>> consensus_state::take_prepared_proposal() {
+  if (!next_proposal)
+    return {};
+  auto prepared = std::move(next_proposal.value());
+  next_proposal.reset();
+
+  auto last_commit_power = rs.height == local_state.initial_height ? 0 : rs.last_commit->sum;
+  if (prepared.height != rs.height || prepared.last_commit_power != last_commit_power ||
+    prepared.evidence_version != (block_exec->ev_pool ? block_exec->ev_pool->get_version() : 0)) {
+    dlog(fmt::format("discarding outdated prepared proposal block: height={}", prepared.height));
+    return {};
+  }
+  auto ret = prepared.result.get();
+  if (!std::get<0>(ret))
+    return {};
+  return ret;
+}
+
 /**
  * Enter after entering propose (proposal block and POL is ready)
  * Prevote for locked_block if we are locked or proposal_blocke if valid. Otherwise vote nil.
@@ -761,7 +869,7 @@ void consensus_state::enter_prevote_wait(int64_t height, int32_t round) {
   });
 
   // Wait for some more prevotes
-  schedule_timeout(cs_config.prevote(round), height, round, round_step_type::PrevoteWait);
+  schedule_timeout(timeouts.prevote(cs_config, round), height, round, round_step_type::PrevoteWait);
 }
 
 /**
@@ -889,7 +997,7 @@ void consensus_state::enter_precommit_wait(int64_t height, int32_t round) {
   });
 
   // wait for more precommits
-  schedule_timeout(cs_config.precommit(round), height, round, round_step_type::PrecommitWait);
+  schedule_timeout(timeouts.precommit(cs_config, round), height, round, round_step_type::PrecommitWait);
 }
 
 void consensus_state::enter_commit(int64_t height, int32_t round) {
@@ -931,6 +1039,7 @@ void consensus_state::enter_commit(int64_t height, int32_t round) {
       // Set up ProposalBlockParts and keep waiting.
       rs.proposal_block = {};
       rs.proposal_block_parts = part_set::new_part_set_from_header(block_id_->parts);
+      publish_round_state();
 
       event_bus_->publish_event_valid_block(events::event_data_round_state{rs});
       event_switch_mq_channel.publish(appbase::priority::medium,
@@ -992,7 +1101,7 @@ void consensus_state::finalize_commit(int64_t height) {
   }
 
   // Write EndHeightMessage{} for this height, implying that the blockstore has saved the block.
-  if (!wal_->write_sync({end_height_message{height}})) {
+  if (!timed("wal_sync", [&]() { return wal_->write_sync({end_height_message{height}}); })) {
     throw std::runtime_error(fmt::format(
       "failed to write end_height_message at height:{} to consensus WAL; check your file system and restart the node",
       height));
@@ -1001,7 +1110,9 @@ void consensus_state::finalize_commit(int64_t height) {
   auto state_copy = local_state;
 
   // Apply block
-  auto result = block_exec->apply_block(state_copy, p2p::block_id{block_->get_hash(), block_parts_->header()}, block_);
+  auto result = timed("apply_block", [&]() {
+    return block_exec->apply_block(state_copy, p2p::block_id{block_->get_hash(), block_parts_->header()}, block_);
+  });
   if (!result.has_value()) {
     elog("failed to apply block");
     return;
@@ -1009,6 +1120,8 @@ void consensus_state::finalize_commit(int64_t height) {
   state_copy = result.value();
 
   // record metric
+  if (height_start_time != std::chrono::steady_clock::time_point{})
+    metrics.observe("height", std::chrono::steady_clock::now() - height_start_time);
 
   // New Height Step!
   update_to_state(state_copy);
@@ -1016,6 +1129,9 @@ void consensus_state::finalize_commit(int64_t height) {
   // Private validator might have changed it's key pair => refetch pubkey.
   update_priv_validator_pub_key();
 
+  // Build our proposal for the next height while waiting for timeout_commit
+  prepare_proposal();
+
   // cs.StartTime is already set.
   // Schedule Round0 to start soon.
   schedule_round_0(rs);
@@ -1059,13 +1175,17 @@ void consensus_state::set_proposal(p2p::proposal_message& msg) {
   }
 
   ilog(fmt::format("received proposal; {}", msg.type));
+  publish_round_state();
+  event_switch_mq_channel.publish(appbase::priority::medium,
+    std::make_shared<plugin_interface::event_info>(plugin_interface::event_info{EventProposalData}));
 }
 
 /**
  * Asynchronously triggers either enterPrevote (before we timeout of propose) or tryFinalizeCommit, once we have full
  * block NOTE: block may be invalid
  */
-bool consensus_state::add_proposal_block_part(p2p::block_part_message& msg, node_id peer_id) {
+bool consensus_state::add_proposal_block_part(
+  p2p::block_part_message& msg, node_id peer_id, const Bytes& verified_part_root) {
   auto height_ = msg.height;
   auto round_ = msg.round;
   auto part_ = std::make_shared<part>(part{msg.index, msg.bytes_, msg.proof});
@@ -1084,7 +1204,24 @@ bool consensus_state::add_proposal_block_part(p2p::block_part_message& msg, node
     return false;
   }
 
-  auto added = rs.proposal_block_parts->add_part(part_);
+  // parts checked by consensus_reactor against the root of this part set are not checked again
+  bool added;
+  if (!verified_part_root.empty() && verified_part_root == rs.proposal_block_parts->hash)
+    added = rs.proposal_block_parts->add_verified_part(part_);
+  else
+    added = rs.proposal_block_parts->add_part(part_);
+  if (added) {
+    if (rs.proposal_block_parts->count == 1)
+      observe_round("round.first_block_part");
+    if (rs.proposal_block_parts->is_complete()) {
+      observe_round("round.last_block_part");
+      // our own proposal completes immediately and says nothing about the network
+      if (!is_proposal(local_priv_validator_pub_key.address()))
+        timeouts.complete_proposal(rs.height, rs.round);
+    }
+    event_switch_mq_channel.publish(appbase::priority::medium,
+      std::make_shared<plugin_interface::event_info>(plugin_interface::event_info{EventProposalData}));
+  }
 
   if (rs.proposal_block_parts->byte_size > local_state.consensus_params_.block.max_bytes) {
     elog(fmt::format("total size of proposal block parts exceeds maximum block Bytes ({} > {})",
@@ -1098,12 +1235,17 @@ bool consensus_state::add_proposal_block_part(p2p::block_part_message& msg, node
       return added;
     }
     rs.proposal_block = new_block_;
+    publish_round_state();
 
     // NOTE: it's possible to receive complete proposal blocks for future rounds without having the proposal
     ilog(fmt::format("received complete proposal block: height={}", rs.proposal_block->header.height));
 
     event_bus_->publish_event_complete_proposal(events::event_data_complete_proposal{rs});
 
+    // Take block execution off the critical path between heights; the result is dropped unless this block commits
+    if (cs_config.optimistic_execution)
+      block_exec->exec_block_optimistically(local_state, rs.proposal_block);
+
     // Update Valid if we can
     auto prevotes = rs.votes->prevotes(rs.round);
     auto block_id_ = prevotes->two_thirds_majority();
@@ -1182,6 +1324,8 @@ std::pair<bool, Error> consensus_state::add_vote(const std::shared_ptr<vote>& vo
       return {false, err};
 
     dlog("added vote to last precommits");
+    if (rs.step == round_step_type::NewHeight)
+      prepare_proposal(); // include the late precommit in our next proposal
     event_bus_->publish_event_vote(events::event_data_vote{.vote = vote_});
 
     event_switch_mq_channel.publish(appbase::priority::medium,
@@ -1206,11 +1350,20 @@ std::pair<bool, Error> consensus_state::add_vote(const std::shared_ptr<vote>& vo
   }
 
   auto height = rs.height;
+  auto had_maj23 = [&]() {
+    auto votes_ = rs.votes->get_vote_set(vote_->round, vote_->type);
+    return votes_ && votes_->has_two_thirds_majority();
+  };
+  auto had_maj23_ = had_maj23();
   auto [added, err] = rs.votes->add_vote(vote_, peer_id);
   if (!added) {
     // Either duplicate, or error upon cs.Votes.AddByIndex()
     return {false, err};
   }
+  if (!had_maj23_ && vote_->round == rs.round && had_maj23()) {
+    observe_round(vote_->type == p2p::Prevote ? "round.prevote_maj23" : "round.precommit_maj23");
+    timeouts.reach_quorum(height, vote_->round, vote_->type);
+  }
 
   event_bus_->publish_event_vote(events::event_data_vote{.vote = vote_});
   event_switch_mq_channel.publish(appbase::priority::medium,
@@ -1258,6 +1411,7 @@ std::pair<bool, Error> consensus_state::add_vote(const std::shared_ptr<vote>& vo
         if (!rs.proposal_block_parts->has_header(block_id_->parts)) {
           rs.proposal_block_parts = part_set::new_part_set_from_header(block_id_->parts);
         }
+        publish_round_state();
 
         event_switch_mq_channel.publish(appbase::priority::medium,
           std::make_shared<plugin_interface::event_info>(
@@ -1315,7 +1469,7 @@ std::pair<bool, Error> consensus_state::add_vote(const std::shared_ptr<vote>& vo
 std::optional<vote> consensus_state::sign_vote(p2p::signed_msg_type msg_type, Bytes hash, p2p::part_set_header header) {
   // Flush the WAL. Otherwise, we may not recompute the same vote to sign,
   // and the privValidator will refuse to sign anything.
-  if (!wal_->flush_and_sync()) {
+  if (!timed("wal_sync", [&]() { return wal_->flush_and_sync(); })) {
     elog("failed to flush wal");
     return {};
   }
@@ -6,10 +6,12 @@
 #pragma once
 #include <noir/common/plugin_interface.h>
 #include <noir/common/thread_pool.h>
+#include <noir/consensus/adaptive_timeouts.h>
 #include <noir/consensus/block_executor.h>
 #include <noir/consensus/common.h>
 #include <noir/consensus/config.h>
 #include <noir/consensus/crypto.h>
+#include <noir/consensus/metrics.h>
 #include <noir/consensus/state.h>
 #include <noir/consensus/types/event_bus.h>
 #include <noir/consensus/types/node_id.h>
@@ -39,7 +41,9 @@ struct consensus_state : public std::enable_shared_from_this<consensus_state> {
 
   state get_state();
   int64_t get_last_height();
-  std::shared_ptr<round_state> get_round_state();
+  /// \brief returns the latest published snapshot of round state without taking mtx
+  /// \note the snapshot is immutable but shares votes and part sets with the live round state
+  std::shared_ptr<const round_state> get_round_state();
   void set_priv_validator(const std::shared_ptr<priv_validator>& priv);
   void update_priv_validator_pub_key();
   void reconstruct_last_commit(state& state_);
@@ -57,6 +61,9 @@ struct consensus_state : public std::enable_shared_from_this<consensus_state> {
   void update_to_state(state& state_);
   void new_step();
 
+  /// \brief publishes a snapshot of rs to readers of get_round_state(); must be called with mtx held
+  void publish_round_state();
+
   void receive_routine(p2p::internal_msg_info_ptr mi);
   void handle_msg();
 
@@ -79,6 +86,11 @@ struct consensus_state : public std::enable_shared_from_this<consensus_state> {
   bool is_proposal(Bytes address);
   void decide_proposal(int64_t height, int32_t round);
 
+  /// \brief builds our proposal block for the current height in the background while waiting for round 0
+  /// \note does nothing unless we are the proposer of round 0; decide_proposal() takes the block if still up to date
+  void prepare_proposal();
+  std::optional<std::tuple<std::shared_ptr<block>, std::shared_ptr<part_set>>> take_prepared_proposal();
+
   void enter_prevote(int64_t height, int32_t round);
   void do_prevote(int64_t height, int32_t round);
 
@@ -90,7 +102,7 @@ struct consensus_state : public std::enable_shared_from_this<consensus_state> {
   void try_finalize_commit(int64_t height);
   void finalize_commit(int64_t height);
   void set_proposal(p2p::proposal_message& msg);
-  bool add_proposal_block_part(p2p::block_part_message& msg, node_id peer_id);
+  bool add_proposal_block_part(p2p::block_part_message& msg, node_id peer_id, const Bytes& verified_part_root = {});
 
   /// \brief attempt to add vote; if it's a duplicate signature, dupeout the validator
   Result<bool> try_add_vote(p2p::vote_message& msg, const node_id& peer_id);
@@ -117,6 +129,7 @@ struct consensus_state : public std::enable_shared_from_this<consensus_state> {
   // internal state
   std::mutex mtx;
   round_state rs{};
+  std::shared_ptr<const round_state> rs_snapshot; ///< read and replaced with std::atomic_load/atomic_store only
   state local_state; // State until height-1.
   pub_key local_priv_validator_pub_key;
 
@@ -141,8 +154,46 @@ struct consensus_state : public std::enable_shared_from_this<consensus_state> {
   std::optional<named_thread_pool> thread_pool;
   timeout_info_ptr old_ti;
 
+  /// proposal block being built by prepare_proposal(), with the inputs it depends on
+  struct prepared_proposal {
+    int64_t height;
+    int64_t last_commit_power;
+    uint64_t evidence_version;
+    std::future<std::tuple<std::shared_ptr<block>, std::shared_ptr<part_set>>> result;
+  };
+  std::optional<prepared_proposal> next_proposal;
+  std::optional<named_thread_pool> proposal_thread_pool;
+
   int n_steps{}; // for tests where we want to limit the number of transitions the state makes
 
+  // latencies of steps and events of each height, see consensus_metrics for the names recorded
+  consensus_metrics metrics;
+  adaptive_timeouts timeouts;
+  p2p::round_step_type metered_step{};
+  std::chrono::steady_clock::time_point step_start_time{};
+  std::chrono::steady_clock::time_point round_start_time{};
+  std::chrono::steady_clock::time_point height_start_time{};
+
+  /// \brief records the time spent in the previous step and starts timing rs.step
+  /// Called on every step change, including NewRound which does not go through new_step().
+  /// \return time the current step started
+  std::chrono::steady_clock::time_point meter_step();
+
+  /// \brief records the time elapsed since the start of the current round
+  void observe_round(const std::string& name) {
+    if (round_start_time != std::chrono::steady_clock::time_point{})
+      metrics.observe(name, std::chrono::steady_clock::now() - round_start_time);
+  }
+
+  /// \brief runs f and records its duration
+  template<typename F>
+  auto timed(const std::string& name, F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    auto ret = f();
+    metrics.observe(name, std::chrono::steady_clock::now() - start);
+    return ret;
+  }
+
   // we use eventBus to trigger msg broadcasts in the reactor,
   // and to notify external subscribers, eg. through a websocket
   std::shared_ptr<events::event_bus> event_bus_;
@@ -4,8 +4,14 @@
 // SPDX-License-Identifier: AGPL-3.0-or-later
 //
 #include <noir/common/check.h>
+#include <noir/common/thread_pool.h>
 #include <noir/consensus/common.h>
 #include <noir/consensus/crypto.h>
+#include <noir/consensus/ed25519.h>
+#include <noir/crypto/hash/sha2.h>
+#include <algorithm>
+#include <cstring>
+#include <thread>
 
 extern "C" {
 #include <sodium.h>
@@ -35,24 +41,164 @@ namespace detail {
       return true;
     return false;
   }
+
+  bool cached_verify(const Bytes& sig, const Bytes& msg, const Bytes& key) {
+    auto& cache = signature_cache::instance();
+    auto digest = signature_cache::digest(key, msg, sig);
+    if (cache.contains(digest))
+      return true;
+    if (!verify(sig, msg, key))
+      return false;
+    cache.add(digest);
+    return true;
+  }
 } // namespace detail
 
+named_thread_pool& verifier_pool() {
+  static named_thread_pool pool("verify", std::max(1u, std::thread::hardware_concurrency()));
+  return pool;
+}
+
 Bytes pub_key::address() {
   check(key.size() == pub_key_size, "pub_key: unable to derive address as key has incorrect size");
-  auto h = crypto::Sha256()(key);
+  auto h = crypto::sha256(key);
   return {h.begin(), h.begin() + 20};
 }
 
-bool pub_key::verify_signature(const Bytes& msg, const Bytes& sig) {
+bool pub_key::verify_signature(const Bytes& msg, const Bytes& sig) const {
   if (sig.size() != signature_size)
     return false;
-  return detail::verify(sig, msg, key);
+  return detail::cached_verify(sig, msg, key);
 }
 
 std::string pub_key::get_type() const {
   return std::string(key_type);
 }
 
+signature_cache::signature_cache(size_t capacity)
+  : shard_capacity(std::max<size_t>(1, (capacity + num_shards - 1) / num_shards)) {}
+
+signature_cache& signature_cache::instance() {
+  static signature_cache cache;
+  return cache;
+}
+
+Bytes signature_cache::digest(const Bytes& key, const Bytes& msg, const Bytes& sig) {
+  auto msg_hash = crypto::Sha256()(msg);
+  return crypto::Sha256().init().update(key).update(msg_hash).update(sig).final();
+}
+
+size_t signature_cache::digest_hash::operator()(const Bytes& digest) const {
+  size_t h{0};
+  std::memcpy(&h, digest.data(), std::min(sizeof(h), digest.size()));
+  return h;
+}
+
+signature_cache::shard& signature_cache::shard_of(const Bytes& digest) {
+  return shards[digest.empty() ? 0 : digest.back() % num_shards];
+}
+
+bool signature_cache::contains(const Bytes& digest) {
+  auto& s = shard_of(digest);
+  std::scoped_lock g(s.mtx);
+  auto& list = s.entries.get<0>();
+  auto& map = s.entries.get<1>();
+  if (auto it = map.find(digest); it != map.end()) {
+    list.splice(list.end(), list, s.entries.project<0>(it));
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+  misses_.fetch_add(1, std::memory_order_relaxed);
+  return false;
+}
+
+void signature_cache::add(const Bytes& digest) {
+  auto& s = shard_of(digest);
+  std::scoped_lock g(s.mtx);
+  auto& list = s.entries.get<0>();
+  if (!list.push_back(digest).second)
+    return;
+  if (list.size() > shard_capacity)
+    list.pop_front();
+}
+
+void signature_cache::clear() {
+  for (auto& s : shards) {
+    std::scoped_lock g(s.mtx);
+    s.entries.clear();
+  }
+  hits_ = 0;
+  misses_ = 0;
+}
+
+size_t signature_cache::size() const {
+  size_t ret{0};
+  for (auto& s : shards) {
+    std::scoped_lock g(s.mtx);
+    ret += s.entries.size();
+  }
+  return ret;
+}
+
+void batch_verifier::add(const pub_key& key, Bytes msg, Bytes sig) {
+  entries.push_back({key.key, std::move(msg), std::move(sig)});
+}
+
+std::pair<bool, std::vector<bool>> batch_verifier::verify() const {
+  auto& cache = signature_cache::instance();
+  std::vector<ed25519::signed_message> batch;
+  std::vector<Bytes> digests;
+  for (auto& e : entries) {
+    auto digest = signature_cache::digest(e.key, e.msg, e.sig);
+    if (cache.contains(digest))
+      continue;
+    batch.push_back({{e.key.data(), e.key.size()}, {e.msg.data(), e.msg.size()}, {e.sig.data(), e.sig.size()}});
+    digests.push_back(std::move(digest));
+  }
+  // a single signature is verified faster on its own
+  if (batch.empty() || (batch.size() > 1 && ed25519::verify_batch(batch))) {
+    for (auto& digest : digests)
+      cache.add(digest);
+    return {true, std::vector<bool>(entries.size(), true)};
+  }
+  return verify_each();
+}
+
+std::pair<bool, std::vector<bool>> batch_verifier::verify_each() const {
+  // NOTE: std::vector<bool> is not safe to be written concurrently
+  std::vector<uint8_t> valid(entries.size(), 0);
+  auto verify_range = [this, &valid](size_t begin, size_t end) {
+    for (auto i = begin; i < end; ++i) {
+      auto& e = entries[i];
+      valid[i] = e.sig.size() == signature_size && e.key.size() == pub_key_size &&
+        detail::cached_verify(e.sig, e.msg, e.key);
+    }
+  };
+
+  auto n = entries.size();
+  auto& pool = verifier_pool();
+  if (n < min_parallel_size || pool.get_executor().get_executor().running_in_this_thread()) {
+    verify_range(0, n);
+  } else {
+    size_t num_chunks =
+      std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), n / (min_parallel_size / 2));
+    auto chunk_size = (n + num_chunks - 1) / num_chunks;
+    std::vector<std::future<void>> chunks;
+    for (size_t begin = chunk_size; begin < n; begin += chunk_size) {
+      chunks.push_back(async_thread_pool(pool.get_executor(),
+        [&verify_range, begin, end = std::min(begin + chunk_size, n)]() { verify_range(begin, end); }));
+    }
+    // the calling thread takes the first chunk instead of idling
+    verify_range(0, std::min(chunk_size, n));
+    for (auto& c : chunks) {
+      c.get();
+    }
+  }
+
+  std::vector<bool> ret(valid.begin(), valid.end());
+  return {std::all_of(valid.begin(), valid.end(), [](auto v) { return v; }), std::move(ret)};
+}
+
 priv_key priv_key::new_priv_key() {
   Bytes pub_key_(pub_key_size), priv_key_(priv_key_size);
   crypto_sign_keypair(
@@ -6,8 +6,15 @@
 #pragma once
 #include <noir/common/bytes.h>
 #include <noir/common/refl.h>
+#include <noir/common/thread_pool.h>
 #include <noir/core/result.h>
 #include <tendermint/crypto/keys.pb.h>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+#include <boost/multi_index_container.hpp>
+#include <array>
+#include <atomic>
+#include <mutex>
 
 namespace noir::consensus {
 
@@ -24,7 +31,7 @@ struct pub_key {
     return key;
   }
 
-  bool verify_signature(const Bytes& msg, const Bytes& sig);
+  bool verify_signature(const Bytes& msg, const Bytes& sig) const;
 
   std::string get_type() const;
 
@@ -52,6 +59,107 @@ struct pub_key {
   }
 };
 
+/// \brief bounded LRU cache of successfully verified signatures
+/// Entries are keyed by a digest of (public key, sign bytes, signature) and spread over independently locked shards.
+class signature_cache {
+public:
+  explicit signature_cache(size_t capacity = default_capacity);
+
+  /// \brief returns the process-wide cache consulted by pub_key::verify_signature
+  static signature_cache& instance();
+
+  /// \brief computes the cache key of a signature
+  static Bytes digest(const Bytes& key, const Bytes& msg, const Bytes& sig);
+
+  /// \brief looks up a cache key, updating hit/miss counters
+  /// \param[in] digest cache key returned by digest()
+  /// \return true if the signature was verified before
+  bool contains(const Bytes& digest);
+
+  /// \brief records a successfully verified signature, evicting the least recently used entry if the shard is full
+  void add(const Bytes& digest);
+
+  void clear();
+
+  size_t size() const;
+
+  uint64_t hits() const {
+    return hits_.load(std::memory_order_relaxed);
+  }
+
+  uint64_t misses() const {
+    return misses_.load(std::memory_order_relaxed);
+  }
+
+  static constexpr size_t default_capacity = 1 << 16;
+  static constexpr size_t num_shards = 16;
+
+private:
+  struct digest_hash {
+    size_t operator()(const Bytes& digest) const;
+  };
+
+  // clang-format off
+  using digests = boost::multi_index_container<
+    Bytes,
+    boost::multi_index::indexed_by<
+      boost::multi_index::sequenced<>,
+      boost::multi_index::hashed_unique<boost::multi_index::identity<Bytes>, digest_hash>
+    >
+  >;
+  // clang-format on
+
+  struct shard {
+    mutable std::mutex mtx;
+    digests entries;
+  };
+
+  shard& shard_of(const Bytes& digest);
+
+  size_t shard_capacity;
+  std::array<shard, num_shards> shards;
+  std::atomic<uint64_t> hits_{0};
+  std::atomic<uint64_t> misses_{0};
+};
+
+/// \brief returns the pool shared by all signature verification done off the calling thread
+/// Sized to the number of hardware threads; batch_verifier and consensus_reactor both post their work here.
+named_thread_pool& verifier_pool();
+
+/// \brief verifies a set of ed25519 signatures together
+/// Signatures not found in signature_cache are checked in one ed25519::verify_batch() call. If the batch fails, each
+/// signature is verified on its own to find the invalid ones; large sets are then split across verifier_pool(), unless
+/// called from a verifier_pool() thread, which must not block waiting for the pool.
+class batch_verifier {
+public:
+  /// \brief queues a signature for verification
+  /// \param[in] key public key of the signer
+  /// \param[in] msg signed message
+  /// \param[in] sig signature
+  void add(const pub_key& key, Bytes msg, Bytes sig);
+
+  size_t size() const {
+    return entries.size();
+  }
+
+  /// \brief verifies all queued signatures
+  /// \return pair of overall result and per-signature results in the order they were added
+  std::pair<bool, std::vector<bool>> verify() const;
+
+  /// \brief after a failed batch, sets smaller than this are verified on the calling thread
+  static constexpr size_t min_parallel_size = 16;
+
+private:
+  std::pair<bool, std::vector<bool>> verify_each() const;
+
+  struct entry {
+    Bytes key;
+    Bytes msg;
+    Bytes sig;
+  };
+  std::vector<entry> entries;
+};
+
 struct priv_key {
   Bytes key;
 
@@ -0,0 +1,362 @@
+// This file is part of NOIR.
+//
+// Copyright (c) 2022 Haderech Pte. Ltd.
+// SPDX-License-Identifier: AGPL-3.0-or-later
+//
+#include <noir/consensus/ed25519.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+extern "C" {
+#include <sodium.h>
+}
+
+namespace noir::consensus::ed25519 {
+
+namespace {
+  // Field elements modulo p = 2^255 - 19 in five 51-bit limbs; limbs may exceed 51 bits between reductions
+  using fe = std::array<uint64_t, 5>;
+  using uint128 = unsigned __int128;
+
+  constexpr uint64_t mask51 = (uint64_t(1) << 51) - 1;
+
+  constexpr fe fe_zero{0, 0, 0, 0, 0};
+  constexpr fe fe_one{1, 0, 0, 0, 0};
+  constexpr fe fe_d{0x34dca135978a3, 0x1a8283b156ebd, 0x5e7a26001c029, 0x739c663a03cbb, 0x52036cee2b6ff};
+  constexpr fe fe_d2{0x69b9426b2f159, 0x35050762add7a, 0x3cf44c0038052, 0x6738cc7407977, 0x2406d9dc56dff};
+  constexpr fe fe_sqrtm1{0x61b274a0ea0b0, 0xd5a5fc8f189d, 0x7ef5e9cbd0c60, 0x78595a6804c9e, 0x2b8324804fc1d};
+
+  fe fe_carry(fe r) {
+    uint64_t c;
+    c = r[0] >> 51, r[0] &= mask51, r[1] += c;
+    c = r[1] >> 51, r[1] &= mask51, r[2] += c;
+    c = r[2] >> 51, r[2] &= mask51, r[3] += c;
+    c = r[3] >> 51, r[3] &= mask51, r[4] += c;
+    c = r[4] >> 51, r[4] &= mask51, r[0] += c * 19;
+    return r;
+  }
+
+  fe fe_add(const fe& a, const fe& b) {
+    return {a[0] + b[0], a[1] + b[1], a[2] + b[2], a[3] + b[3], a[4] + b[4]};
+  }
+
+  // Adds 4p so that limbs of b up to 2^53 do not wrap around
+  fe fe_sub(const fe& a, const fe& b) {
+    return fe_carry({a[0] + 0x1fffffffffffb4 - b[0], a[1] + 0x1ffffffffffffc - b[1], a[2] + 0x1ffffffffffffc - b[2],
+      a[3] + 0x1ffffffffffffc - b[3], a[4] + 0x1ffffffffffffc - b[4]});
+  }
+
+  fe fe_neg(const fe& a) {
+    return fe_sub(fe_zero, a);
+  }
+
+  fe fe_reduce_wide(uint128 t0, uint128 t1, uint128 t2, uint128 t3, uint128 t4) {
+    fe r;
+    t1 += t0 >> 51, r[0] = uint64_t(t0) & mask51;
+    t2 += t1 >> 51, r[1] = uint64_t(t1) & mask51;
+    t3 += t2 >> 51, r[2] = uint64_t(t2) & mask51;
+    t4 += t3 >> 51, r[3] = uint64_t(t3) & mask51;
+    uint128 c = (t4 >> 51) * 19 + r[0];
+    r[4] = uint64_t(t4) & mask51;
+    r[0] = uint64_t(c) & mask51;
+    r[1] += uint64_t(c >> 51);
+    return r;
+  }
+
+  fe fe_mul(const fe& a, const fe& b) {
+    uint64_t b1 = b[1] * 19, b2 = b[2] * 19, b3 = b[3] * 19, b4 = b[4] * 19;
+    auto m = [](uint64_t x, uint64_t y) { return uint128(x) * y; };
+    return fe_reduce_wide(m(a[0], b[0]) + m(a[1], b4) + m(a[2], b3) + m(a[3], b2) + m(a[4], b1),
+      m(a[0], b[1]) + m(a[1], b[0]) + m(a[2], b4) + m(a[3], b3) + m(a[4], b2),
+      m(a[0], b[2]) + m(a[1], b[1]) + m(a[2], b[0]) + m(a[3], b4) + m(a[4], b3),
+      m(a[0], b[3]) + m(a[1], b[2]) + m(a[2], b[1]) + m(a[3], b[0]) + m(a[4], b4),
+      m(a[0], b[4]) + m(a[1], b[3]) + m(a[2], b[2]) + m(a[3], b[1]) + m(a[4], b[0]));
+  }
+
+  fe fe_sq(const fe& a) {
+    uint64_t a0_2 = a[0] * 2, a1_2 = a[1] * 2, a2_2 = a[2] * 2, a3_2 = a[3] * 2;
+    uint64_t a3_19 = a[3] * 19, a4_19 = a[4] * 19;
+    auto m = [](uint64_t x, uint64_t y) { return uint128(x) * y; };
+    return fe_reduce_wide(m(a[0], a[0]) + m(a1_2, a4_19) + m(a2_2, a3_19),
+      m(a0_2, a[1]) + m(a2_2, a4_19) + m(a[3], a3_19), m(a0_2, a[2]) + m(a[1], a[1]) + m(a3_2, a4_19),
+      m(a0_2, a[3]) + m(a1_2, a[2]) + m(a[4], a4_19), m(a0_2, a[4]) + m(a1_2, a[3]) + m(a[2], a[2]));
+  }
+
+  fe fe_sqn(fe a, int n) {
+    while (n-- > 0)
+      a = fe_sq(a);
+    return a;
+  }
+
+  // z^((p - 5) / 8) = z^(2^252 - 3)
+  fe fe_pow22523(const fe& z) {
+    auto t0 = fe_sq(z);
+    auto t1 = fe_mul(z, fe_sqn(t0, 2)); // z^9
+    t0 = fe_mul(t0, t1); // z^11
+    t0 = fe_mul(t1, fe_sq(t0)); // z^(2^5 - 1)
+    t0 = fe_mul(fe_sqn(t0, 5), t0); // z^(2^10 - 1)
+    t1 = fe_mul(fe_sqn(t0, 10), t0); // z^(2^20 - 1)
+    t1 = fe_mul(fe_sqn(t1, 20), t1); // z^(2^40 - 1)
+    t0 = fe_mul(fe_sqn(t1, 10), t0); // z^(2^50 - 1)
+    t1 = fe_mul(fe_sqn(t0, 50), t0); // z^(2^100 - 1)
+    t1 = fe_mul(fe_sqn(t1, 100), t1); // z^(2^200 - 1)
+    t0 = fe_mul(fe_sqn(t1, 50), t0); // z^(2^250 - 1)
+    return fe_mul(fe_sqn(t0, 2), z); // z^(2^252 - 3)
+  }
+
+  std::array<unsigned char, 32> fe_tobytes(const fe& a) {
+    auto h = fe_carry(fe_carry(a));
+    // h is now below 2^255 + 19; subtract p if h >= p
+    uint64_t q = (h[0] + 19) >> 51;
+    q = (h[1] + q) >> 51;
+    q = (h[2] + q) >> 51;
+    q = (h[3] + q) >> 51;
+    q = (h[4] + q) >> 51;
+    h[0] += 19 * q;
+    h[1] += h[0] >> 51, h[0] &= mask51;
+    h[2] += h[1] >> 51, h[1] &= mask51;
+    h[3] += h[2] >> 51, h[2] &= mask51;
+    h[4] += h[3] >> 51, h[3] &= mask51;
+    h[4] &= mask51;
+
+    uint64_t w[4] = {h[0] | h[1] << 51, h[1] >> 13 | h[2] << 38, h[2] >> 26 | h[3] << 25, h[3] >> 39 | h[4] << 12};
+    std::array<unsigned char, 32> s;
+    for (auto i = 0; i < 32; i++)
+      s[i] = static_cast<unsigned char>(w[i / 8] >> (8 * (i % 8)));
+    return s;
+  }
+
+  fe fe_frombytes(const unsigned char* s) {
+    uint64_t w[4]{};
+    for (auto i = 0; i < 32; i++)
+      w[i / 8] |= uint64_t(s[i]) << (8 * (i % 8));
+    return {w[0] & mask51, (w[0] >> 51 | w[1] << 13) & mask51, (w[1] >> 38 | w[2] << 26) & mask51,
+      (w[2] >> 25 | w[3] << 39) & mask51, (w[3] >> 12) & mask51};
+  }
+
+  bool fe_iszero(const fe& a) {
+    auto s = fe_tobytes(a);
+    return std::all_of(s.begin(), s.end(), [](auto c) { return c == 0; });
+  }
+
+  bool fe_isnegative(const fe& a) {
+    return fe_tobytes(a)[0] & 1;
+  }
+
+  // Points in extended coordinates (x = X/Z, y = Y/Z, xy = T/Z) and the intermediate forms of ref10
+  struct ge_p2 {
+    fe X, Y, Z;
+  };
+  struct ge_p3 {
+    fe X, Y, Z, T;
+  };
+  struct ge_p1p1 {
+    fe X, Y, Z, T;
+  };
+  struct ge_cached {
+    fe YplusX, YminusX, Z, T2d;
+  };
+
+  ge_p2 to_p2(const ge_p1p1& p) {
+    return {fe_mul(p.X, p.T), fe_mul(p.Y, p.Z), fe_mul(p.Z, p.T)};
+  }
+
+  ge_p3 to_p3(const ge_p1p1& p) {
+    return {fe_mul(p.X, p.T), fe_mul(p.Y, p.Z), fe_mul(p.Z, p.T), fe_mul(p.X, p.Y)};
+  }
+
+  ge_cached to_cached(const ge_p3& p) {
+    return {fe_add(p.Y, p.X), fe_sub(p.Y, p.X), p.Z, fe_mul(p.T, fe_d2)};
+  }
+
+  ge_p1p1 ge_dbl(const ge_p2& p) {
+    auto XX = fe_sq(p.X);
+    auto YY = fe_sq(p.Y);
+    auto ZZ2 = fe_sq(p.Z);
+    ZZ2 = fe_add(ZZ2, ZZ2);
+    auto AA = fe_sq(fe_add(p.X, p.Y));
+    auto Y = fe_add(YY, XX);
+    auto Z = fe_sub(YY, XX);
+    return {fe_sub(AA, Y), Y, Z, fe_sub(ZZ2, Z)};
+  }
+
+  ge_p1p1 ge_dbl(const ge_p3& p) {
+    return ge_dbl(ge_p2{p.X, p.Y, p.Z});
+  }
+
+  ge_p1p1 ge_add(const ge_p3& p, const ge_cached& q) {
+    auto A = fe_mul(fe_add(p.Y, p.X), q.YplusX);
+    auto B = fe_mul(fe_sub(p.Y, p.X), q.YminusX);
+    auto C = fe_mul(q.T2d, p.T);
+    auto D = fe_mul(p.Z, q.Z);
+    D = fe_add(D, D);
+    return {fe_sub(A, B), fe_add(A, B), fe_add(D, C), fe_sub(D, C)};
+  }
+
+  ge_p1p1 ge_sub(const ge_p3& p, const ge_cached& q) {
+    auto A = fe_mul(fe_add(p.Y, p.X), q.YminusX);
+    auto B = fe_mul(fe_sub(p.Y, p.X), q.YplusX);
+    auto C = fe_mul(q.T2d, p.T);
+    auto D = fe_mul(p.Z, q.Z);
+    D = fe_add(D, D);
+    return {fe_sub(A, B), fe_add(A, B), fe_sub(D, C), fe_add(D, C)};
+  }
+
+  bool is_identity(const ge_p2& p) {
+    return fe_iszero(p.X) && fe_iszero(fe_sub(p.Y, p.Z));
+  }
+
+  bool has_small_order(const ge_p3& p) {
+    return is_identity(to_p2(ge_dbl(to_p2(ge_dbl(to_p2(ge_dbl(p)))))));
+  }
+
+  // Decodes a canonical encoding of a point; x = sqrt((y^2 - 1) / (d * y^2 + 1)) with the sign given by the top bit
+  bool decode_point(ge_p3& r, const unsigned char* s) {
+    auto y = fe_frombytes(s);
+    if (auto enc = fe_tobytes(y); !std::equal(s, s + 31, enc.begin()) || (s[31] & 0x7f) != enc[31])
+      return false;
+    auto yy = fe_sq(y);
+    auto u = fe_sub(yy, fe_one);
+    auto v = fe_add(fe_mul(yy, fe_d), fe_one);
+    auto v3 = fe_mul(fe_sq(v), v);
+    auto x = fe_mul(fe_mul(fe_pow22523(fe_mul(fe_mul(fe_sq(v3), v), u)), v3), u);
+
+    auto vxx = fe_mul(fe_sq(x), v);
+    if (!fe_iszero(fe_sub(vxx, u))) {
+      if (!fe_iszero(fe_add(vxx, u)))
+        return false;
+      x = fe_mul(x, fe_sqrtm1);
+    }
+    bool sign = s[31] >> 7;
+    if (sign && fe_iszero(x))
+      return false;
+    if (fe_isnegative(x) != sign)
+      x = fe_neg(x);
+    r = {x, y, fe_one, fe_mul(x, y)};
+    return true;
+  }
+
+  constexpr std::array<unsigned char, 32> group_order{0xed, 0xd3, 0xf5, 0x5c, 0x1a, 0x63, 0x12, 0x58, 0xd6, 0x9c, 0xf7,
+    0xa2, 0xde, 0xf9, 0xde, 0x14, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x10};
+
+  bool is_canonical_scalar(const unsigned char* s) {
+    for (auto i = 31; i >= 0; i--) {
+      if (s[i] != group_order[i])
+        return s[i] < group_order[i];
+    }
+    return false;
+  }
+
+  // Signed digits in [-15, 15], all odd or zero, such that sum(r[i] * 2^i) is the scalar (ref10 slide)
+  void slide(signed char* r, const unsigned char* a) {
+    for (auto i = 0; i < 256; i++)
+      r[i] = 1 & (a[i >> 3] >> (i & 7));
+    for (auto i = 0; i < 256; i++) {
+      if (!r[i])
+        continue;
+      for (auto b = 1; b <= 6 && i + b < 256; b++) {
+        if (!r[i + b])
+          continue;
+        if (r[i] + (r[i + b] << b) <= 15) {
+          r[i] += r[i + b] << b;
+          r[i + b] = 0;
+        } else if (r[i] - (r[i + b] << b) >= -15) {
+          r[i] -= r[i + b] << b;
+          for (auto k = i + b; k < 256; k++) {
+            if (!r[k]) {
+              r[k] = 1;
+              break;
+            }
+            r[k] = 0;
+          }
+        } else {
+          break;
+        }
+      }
+    }
+  }
+
+  /// Straus' method: the doublings are shared by all points, each point adds its odd multiples 1P, 3P, ..., 15P
+  class multiscalar_mul {
+  public:
+    void add(const ge_p3& p, const unsigned char* scalar) {
+      auto& t = tables.emplace_back();
+      t[0] = to_cached(p);
+      auto p2 = to_p3(ge_dbl(p));
+      for (auto i = 1; i < 8; i++)
+        t[i] = to_cached(to_p3(ge_add(p2, t[i - 1])));
+      auto& d = digits.emplace_back();
+      slide(d.data(), scalar);
+    }
+
+    ge_p2 compute() const {
+      ge_p2 r{fe_zero, fe_one, fe_one};
+      auto top = 255;
+      while (top >= 0 && std::all_of(digits.begin(), digits.end(), [&](auto& d) { return d[top] == 0; }))
+        top--;
+      for (auto i = top; i >= 0; i--) {
+        auto t = ge_dbl(r);
+        for (size_t j = 0; j < digits.size(); j++) {
+          if (auto d = digits[j][i]; d > 0)
+            t = ge_add(to_p3(t), tables[j][d / 2]);
+          else if (d < 0)
+            t = ge_sub(to_p3(t), tables[j][-d / 2]);
+        }
+        r = to_p2(t);
+      }
+      return r;
+    }
+
+  private:
+    std::vector<std::array<ge_cached, 8>> tables;
+    std::vector<std::array<signed char, 256>> digits;
+  };
+
+  ge_p3 base_point() {
+    return {{0x62d608f25d51a, 0x412a4b4f6592a, 0x75b7171a4b31d, 0x1ff60527118fe, 0x216936d3cd6e5},
+      {0x6666666666658, 0x4cccccccccccc, 0x1999999999999, 0x3333333333333, 0x6666666666666}, fe_one,
+      {0x68ab3a5b7dda3, 0xeea2a5eadbb, 0x2af8df483c27e, 0x332b375274732, 0x67875f0fd78b7}};
+  }
+} // namespace
+
+bool verify_batch(std::span<const signed_message> sigs) {
+  multiscalar_mul msm;
+  unsigned char base_scalar[32]{};
+  for (auto& e : sigs) {
+    if (e.key.size() != 32 || e.sig.size() != 64)
+      return false;
+    auto r_bytes = e.sig.data();
+    auto s_bytes = e.sig.data() + 32;
+    ge_p3 A, R;
+    if (!is_canonical_scalar(s_bytes) || !decode_point(A, e.key.data()) || has_small_order(A) ||
+      !decode_point(R, r_bytes) || has_small_order(R))
+      return false;
+
+    unsigned char digest[crypto_hash_sha512_BYTES];
+    crypto_hash_sha512_state st;
+    crypto_hash_sha512_init(&st);
+    crypto_hash_sha512_update(&st, r_bytes, 32);
+    crypto_hash_sha512_update(&st, e.key.data(), 32);
+    crypto_hash_sha512_update(&st, e.msg.data(), e.msg.size());
+    crypto_hash_sha512_final(&st, digest);
+    unsigned char h[32], z[32]{}, zh[32], zs[32];
+    crypto_core_ed25519_scalar_reduce(h, digest);
+    randombytes_buf(z, 16);
+    crypto_core_ed25519_scalar_mul(zh, z, h);
+    crypto_core_ed25519_scalar_mul(zs, z, s_bytes);
+    crypto_core_ed25519_scalar_add(base_scalar, base_scalar, zs);
+
+    msm.add(R, z);
+    msm.add(A, zh);
+  }
+  crypto_core_ed25519_scalar_negate(base_scalar, base_scalar);
+  msm.add(base_point(), base_scalar);
+
+  auto r = msm.compute();
+  return is_identity(to_p2(ge_dbl(to_p2(ge_dbl(to_p2(ge_dbl(r)))))));
+}
+
+} // namespace noir::consensus::ed25519
@@ -0,0 +1,29 @@
+// This file is part of NOIR.
+//
+// Copyright (c) 2022 Haderech Pte. Ltd.
+// SPDX-License-Identifier: AGPL-3.0-or-later
+//
+#pragma once
+#include <span>
+
+namespace noir::consensus::ed25519 {
+
+/// \brief ed25519 signature to be verified in a batch
+struct signed_message {
+  std::span<const unsigned char> key;
+  std::span<const unsigned char> msg;
+  std::span<const unsigned char> sig;
+};
+
+/// \brief checks a set of ed25519 signatures at once
+///
+/// Signatures are combined with random 128-bit coefficients and checked with a single multi-scalar multiplication,
+/// [8](sum(z_i * R_i) + sum(z_i * h_i * A_i) - sum(z_i * s_i) * B) == 0.
+/// Encodings libsodium rejects (non-canonical s, A or R, small order A or R, points not on the curve) fail the batch.
+/// NOTE: the equation is cofactored, so unlike crypto_sign_verify_detached, it also accepts a signature whose R or A
+/// has an additional small order component. Conforming signers never produce one.
+/// \param[in] sigs signatures to check
+/// \return true if all signatures are valid; false if any of them is not, without telling which
+bool verify_batch(std::span<const signed_message> sigs);
+
+} // namespace noir::consensus::ed25519
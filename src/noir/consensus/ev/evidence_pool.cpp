@@ -4,6 +4,7 @@
 // SPDX-License-Identifier: AGPL-3.0-or-later
 //
 #include <noir/codec/protobuf.h>
+#include <noir/common/check.h>
 #include <noir/consensus/ev/evidence_pool.h>
 
 namespace noir::consensus::ev {
@@ -28,6 +29,7 @@ void evidence_pool::mark_evidence_as_committed(const evidence_list& evs, int64_t
   evidence_store->erase(batch_delete);
   remove_evidence_from_list(block_evidence_map);
   std::atomic_fetch_sub_explicit(&evidence_size, block_evidence_map.size(), std::memory_order_relaxed);
+  evidence_version.fetch_add(1, std::memory_order_release);
 }
 
 Result<std::pair<std::vector<std::shared_ptr<evidence>>, int64_t>> evidence_pool::list_evidence(
@@ -64,6 +66,7 @@ std::pair<int64_t, tstamp> evidence_pool::remove_expired_pending_evidence() {
   evidence_store->erase(batch_delete);
   remove_evidence_from_list(block_evidence_map);
   std::atomic_fetch_sub_explicit(&evidence_size, block_evidence_map.size(), std::memory_order_relaxed);
+  evidence_version.fetch_add(1, std::memory_order_release);
   return {height, time};
 }
 
@@ -140,7 +143,8 @@ Result<void> evidence_pool::verify(const std::shared_ptr<evidence>& ev) {
       return ok.error();
 
     auto val_op = val_set->get_by_address(ev_d->vote_a->validator_address);
-    auto val = std::make_shared<validator>(val_op.value());
+    check(val_op, "unable to find validator in validator_set");
+    auto val = std::make_shared<validator>(*val_op);
     if (auto ok = ev_d->validate_abci(val, val_set, ev_time); !ok) {
       ev_d->generate_abci(val, val_set, ev_time);
       if (auto add_err = add_pending_evidence(ev); !add_err)
@@ -186,7 +190,7 @@ Result<void> evidence_pool::verify(const std::shared_ptr<evidence>& ev) {
 Result<void> evidence_pool::verify_duplicate_vote(
   const duplicate_vote_evidence& ev, const std::string& chain_id, const std::shared_ptr<validator_set>& val_set) {
   auto val = val_set->get_by_address(ev.vote_a->validator_address);
-  if (!val.has_value())
+  if (!val)
     return Error::format("address was not a validator at height={}", ev.get_height());
   auto pub_key_ = val->pub_key_;
 
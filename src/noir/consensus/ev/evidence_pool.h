@@ -32,6 +32,7 @@ struct evidence_pool {
   std::shared_ptr<db_session_type> evidence_store{};
   std::unique_ptr<clist::CList<std::shared_ptr<evidence>>> ev_list{};
   std::atomic<uint32_t> evidence_size{};
+  std::atomic<uint64_t> evidence_version{}; ///< bumped on every change of the pending evidence
 
   std::shared_ptr<noir::consensus::db_store> state_db{};
   std::shared_ptr<noir::consensus::block_store> block_store{};
@@ -153,6 +154,12 @@ struct evidence_pool {
     return evidence_size.load();
   }
 
+  /// \brief returns a counter which changes whenever evidence becomes or stops being pending
+  /// Unlike get_size(), it tells apart pending lists which merely have the same length.
+  uint64_t get_version() {
+    return evidence_version.load(std::memory_order_acquire);
+  }
+
   noir::consensus::state get_state() {
     std::scoped_lock _(mtx);
     return *state;
@@ -184,6 +191,7 @@ struct evidence_pool {
     auto key = key_pending(ev);
     evidence_store->write_from_bytes(key, ev_bytes); // TODO: check
     std::atomic_fetch_add_explicit(&evidence_size, 1, std::memory_order_relaxed);
+    evidence_version.fetch_add(1, std::memory_order_release);
     return success();
   }
 
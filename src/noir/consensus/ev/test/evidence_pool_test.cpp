@@ -111,6 +111,32 @@ TEST_CASE("evidence_pool: update", "[noir][consensus]") {
   CHECK(pool_->check_evidence({.list = {ev}}).error().message() == "evidence was already committed");
 }
 
+TEST_CASE("evidence_pool: version", "[noir][consensus]") {
+  int64_t height{21};
+  auto [pool_, val] = default_test_pool(height);
+  auto state = *pool_->state;
+
+  auto ev_time = get_default_evidence_time() +
+    std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::minutes(21)).count();
+  auto ev_a = new_mock_duplicate_vote_evidence_with_validator(height, ev_time, evidence_chain_id, *val);
+  auto ev_b = new_mock_duplicate_vote_evidence_with_validator(height, ev_time, evidence_chain_id, *val);
+
+  auto version = pool_->get_version();
+  CHECK(pool_->add_evidence(ev_a));
+  CHECK(pool_->get_size() == 1);
+  CHECK(pool_->get_version() != version);
+
+  // commit one evidence and receive another one: the count is the same, but the pending evidence is not
+  version = pool_->get_version();
+  state.last_block_height = height + 1;
+  state.last_block_time = get_default_evidence_time() +
+    std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::minutes(22)).count();
+  pool_->update(state, {.list = {ev_a}});
+  CHECK(pool_->add_evidence(ev_b));
+  CHECK(pool_->get_size() == 1);
+  CHECK(pool_->get_version() != version);
+}
+
 TEST_CASE("evidence_pool: verify pending evidence passes", "[noir][consensus]") {
   int64_t height{1};
   auto [pool_, val] = default_test_pool(height);
@@ -127,7 +127,7 @@ inline std::shared_ptr<noir::consensus::db_store> initialize_validator_state(
   auto pub_key_ = priv_val->get_pub_key();
   auto val = validator::new_validator(pub_key_, 10);
   auto val_set = std::make_shared<validator_set>();
-  val_set->validators.push_back(val);
+  val_set->set_validators({val});
   val_set->proposer = val;
   return initialize_state_from_validator_set(val_set, height);
 }
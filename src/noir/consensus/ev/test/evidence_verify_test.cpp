@@ -54,7 +54,7 @@ std::vector<std::shared_ptr<priv_validator>> order_priv_vals_by_val_set(
   const std::shared_ptr<validator_set>& vals, const std::vector<std::shared_ptr<priv_validator>>& priv_vals) {
   std::vector<std::shared_ptr<priv_validator>> output(priv_vals.size());
   size_t idx{};
-  for (auto& v : vals->validators) {
+  for (auto& v : vals->get_validators()) {
     for (auto& p : priv_vals) {
       auto pub_key_ = p->get_pub_key();
       if (v.address == pub_key_.address()) {
@@ -79,7 +79,7 @@ make_lunatic_evidence(int64_t height,
   CHECK(total_vals > byz_vals);
 
   std::vector<validator> byz_val_set{
-    common_val_set->validators.begin(), common_val_set->validators.begin() + byz_vals - 1};
+    common_val_set->get_validators().begin(), common_val_set->get_validators().begin() + byz_vals - 1};
   std::vector<std::shared_ptr<priv_validator>> byz_priv_vals{
     common_priv_vals.begin(), common_priv_vals.begin() + byz_vals - 1};
 
@@ -7,44 +7,51 @@
 
 namespace noir::consensus::merkle {
 
-constexpr int max_aunts{100};
+std::pair<Bytes, std::vector<std::shared_ptr<proof>>> proofs_from_bytes_list(const bytes_list& items) {
+  std::vector<node_hash> leaves(items.size());
+  for (size_t i = 0; i < items.size(); i++)
+    leaf_hash_to(items[i], leaves[i]);
+  return proofs_from_leaf_hashes(std::move(leaves));
+}
 
-std::pair<std::vector<std::shared_ptr<proof_node>>, std::shared_ptr<proof_node>> trails_from_bytes_list(
-  const bytes_list& items) {
-  switch (items.size()) {
-  case 0:
-    return {{}, std::make_shared<proof_node>(proof_node{get_empty_hash()})};
-  case 1: {
-    auto trail = std::make_shared<proof_node>(proof_node{leaf_hash_opt(items[0])});
-    return {{trail}, trail};
-  }
+std::pair<Bytes, std::vector<std::shared_ptr<proof>>> proofs_from_leaf_hashes(std::vector<node_hash> leaves) {
+  if (leaves.empty())
+    return {get_empty_hash(), {}};
+
+  // Levels of the tree from the leaves to the root, back to back. Each level has ceil(n/2) nodes of the one below, so
+  // the buffer holds less than 2n + log2(n) + 1 nodes; its exact size is counted first.
+  auto total = leaves.size();
+  auto size = total;
+  for (auto n = total; n > 1; n = (n + 1) / 2)
+    size += (n + 1) / 2;
+  std::vector<node_hash> nodes = std::move(leaves);
+  std::vector<size_t> offsets{0};
+  nodes.reserve(size);
+  for (auto n = total; n > 1; n = (n + 1) / 2) {
+    auto level = offsets.back();
+    offsets.push_back(nodes.size());
+    nodes.resize(nodes.size() + (n + 1) / 2);
+    hash_level(nodes.data() + level, n, nodes.data() + offsets.back());
   }
-  auto k = get_split_point(items.size());
-  auto [lefts, left_root] = trails_from_bytes_list({items.begin(), items.begin() + k});
-  auto [rights, right_root] = trails_from_bytes_list({items.begin() + k, items.end()});
-  auto root_hash = inner_hash_opt(left_root->hash, right_root->hash);
-  auto root = std::make_shared<proof_node>(proof_node{root_hash});
-  left_root->parent = root;
-  left_root->right = right_root;
-  right_root->parent = root;
-  right_root->left = left_root;
-  std::vector<std::shared_ptr<proof_node>> left_right;
-  left_right.reserve(lefts.size() + rights.size() + 1);
-  left_right.insert(left_right.end(), lefts.begin(), lefts.end());
-  left_right.insert(left_right.end(), rights.begin(), rights.end());
-  return {left_right, root};
-}
+  auto& root = nodes[offsets.back()];
 
-std::pair<Bytes, std::vector<std::shared_ptr<proof>>> proofs_from_bytes_list(const bytes_list& items) {
-  auto [trails, root_spn] = trails_from_bytes_list(items);
-  Bytes root_hash = root_spn->hash;
-  std::vector<std::shared_ptr<proof>> proofs;
-  proofs.resize(items.size());
-  for (auto i = 0; i < trails.size(); i++) {
-    proofs[i] = std::make_shared<proof>(
-      proof{static_cast<int64_t>(items.size()), i, trails[i]->hash, trails[i]->flatten_aunts()});
+  // Aunts of a leaf are the siblings of the nodes on its path, if any; a node without one moves up as is
+  std::vector<std::shared_ptr<proof>> proofs(total);
+  for (size_t i = 0; i < total; i++) {
+    auto p = std::make_shared<proof>(proof{static_cast<int64_t>(total), static_cast<int64_t>(i)});
+    p->leaf_hash = Bytes(nodes[i].begin(), nodes[i].end());
+    p->aunts.reserve(offsets.size() - 1);
+    auto index = i;
+    for (size_t l = 0; l + 1 < offsets.size(); l++, index /= 2) {
+      auto sibling = index ^ 1;
+      if (sibling < offsets[l + 1] - offsets[l]) {
+        auto& aunt = nodes[offsets[l] + sibling];
+        p->aunts.emplace_back(aunt.begin(), aunt.end());
+      }
+    }
+    proofs[i] = std::move(p);
   }
-  return {root_hash, proofs};
+  return {Bytes(root.begin(), root.end()), std::move(proofs)};
 }
 
 } // namespace noir::consensus::merkle
@@ -58,38 +58,16 @@ struct proof {
   }
 };
 
-struct proof_node {
-  Bytes hash{};
-  std::shared_ptr<proof_node> parent{};
-  std::shared_ptr<proof_node> left{};
-  std::shared_ptr<proof_node> right{};
-
-  /// \brief returns inner hashes for the item corresponding to leaf, starting from a leaf proof_node
-  bytes_list flatten_aunts() {
-    if (!parent && !left && !right)
-      return {};
-    bytes_list inner_hashes{};
-    proof_node* cur = this;
-    while (cur != nullptr) {
-      if (cur->left != nullptr)
-        inner_hashes.push_back(cur->left->hash);
-      if (cur->right != nullptr)
-        inner_hashes.push_back(cur->right->hash);
-      cur = cur->parent.get();
-    }
-    return inner_hashes;
-  }
-};
-
-/// \brief recursively constructs merkle proofs
-std::pair<std::vector<std::shared_ptr<proof_node>>, std::shared_ptr<proof_node>> trails_from_bytes_list(
-  const bytes_list& items);
-
 /// \brief computes inclusion proof for given list
 /// \param items list of items used for generating proof
 /// \return list of proofs; proof[0] is the proof for list[0]
 std::pair<Bytes, std::vector<std::shared_ptr<proof>>> proofs_from_bytes_list(const bytes_list& items);
 
+/// \brief computes inclusion proofs of all leaves in one pass, hashing every node of the tree once
+/// \param leaves leaf hashes of items, see leaf_hash_to()
+/// \return root hash and list of proofs; proof[0] is the proof for leaves[0]
+std::pair<Bytes, std::vector<std::shared_ptr<proof>>> proofs_from_leaf_hashes(std::vector<node_hash> leaves);
+
 } // namespace noir::consensus::merkle
 
 NOIR_REFLECT(noir::consensus::merkle::proof, total, index, leaf_hash, aunts);
@@ -0,0 +1,74 @@
+// This file is part of NOIR.
+//
+// Copyright (c) 2022 Haderech Pte. Ltd.
+// SPDX-License-Identifier: AGPL-3.0-or-later
+//
+#include <catch2/catch_all.hpp>
+#include <noir/consensus/merkle/proof.h>
+
+using namespace noir;
+using namespace noir::consensus::merkle;
+
+namespace {
+
+// The former implementation: recursive, copying halves of the list, with an OpenSSL context per node
+Bytes recursive_hash_from_bytes_list(const bytes_list& list) {
+  auto hash = [](std::span<const unsigned char> in) { return crypto::Sha256()(in); };
+  auto leaf_hash = [&](const Bytes& leaf) {
+    Bytes buff;
+    buff.raw().push_back(0);
+    buff.raw().insert(buff.end(), leaf.begin(), leaf.end());
+    return hash(buff);
+  };
+  auto inner_hash = [&](const Bytes& left, const Bytes& right) {
+    Bytes buff;
+    buff.raw().push_back(1);
+    buff.raw().insert(buff.end(), left.begin(), left.end());
+    buff.raw().insert(buff.end(), right.begin(), right.end());
+    return hash(buff);
+  };
+  switch (list.size()) {
+  case 0:
+    return hash({});
+  case 1:
+    return leaf_hash(list[0]);
+  }
+  auto k = get_split_point(list.size());
+  auto left = recursive_hash_from_bytes_list({list.begin(), list.begin() + k});
+  auto right = recursive_hash_from_bytes_list({list.begin() + k, list.end()});
+  return inner_hash(left, right);
+}
+
+bytes_list make_items(size_t count, size_t size) {
+  bytes_list items;
+  for (size_t i = 0; i < count; i++)
+    items.push_back(Bytes(std::vector<unsigned char>(size, static_cast<unsigned char>(i))));
+  return items;
+}
+
+} // namespace
+
+TEST_CASE("MerkleTreeBenchmarks", "[noir][consensus]") {
+  // tx hashes of a block with 10k txs, as in block_data::get_hash
+  auto tx_hashes = make_items(10000, 32);
+  // parts of a 8MB block
+  auto parts = make_items(128, 65536);
+  CHECK(hash_from_bytes_list(tx_hashes) == recursive_hash_from_bytes_list(tx_hashes));
+  CHECK(hash_from_bytes_list(parts) == recursive_hash_from_bytes_list(parts));
+
+  BENCHMARK("Recursive10kTxs") {
+    return recursive_hash_from_bytes_list(tx_hashes);
+  };
+  BENCHMARK("Iterative10kTxs") {
+    return hash_from_bytes_list(tx_hashes);
+  };
+  BENCHMARK("Recursive128Parts") {
+    return recursive_hash_from_bytes_list(parts);
+  };
+  BENCHMARK("Iterative128Parts") {
+    return hash_from_bytes_list(parts);
+  };
+  BENCHMARK("Proofs128Parts") {
+    return proofs_from_bytes_list(parts);
+  };
+}
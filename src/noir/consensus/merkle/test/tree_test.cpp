@@ -6,6 +6,7 @@
 #include <catch2/catch_all.hpp>
 #include <noir/consensus/merkle/proof.h>
 #include <fc/crypto/private_key.hpp>
+#include <functional>
 
 using namespace noir;
 using namespace noir::consensus::merkle;
@@ -45,6 +46,61 @@ TEST_CASE("merkle_tree: Verify hash inputs", "[noir][consensus]") {
   });
 }
 
+TEST_CASE("merkle_tree: Match recursive definition", "[noir][consensus]") {
+  std::function<Bytes(const bytes_list&)> recursive_hash = [&](const bytes_list& list) {
+    switch (list.size()) {
+    case 0:
+      return get_empty_hash();
+    case 1:
+      return leaf_hash_opt(list[0]);
+    }
+    auto k = get_split_point(list.size());
+    return inner_hash_opt(
+      recursive_hash({list.begin(), list.begin() + k}), recursive_hash({list.begin() + k, list.end()}));
+  };
+
+  bytes_list items;
+  for (auto i = 0; i < 130; i++) {
+    CHECK(hash_from_bytes_list(items) == recursive_hash(items));
+    items.push_back(Bytes(std::vector<unsigned char>(i % 70, i)));
+  }
+}
+
+TEST_CASE("merkle_tree: Match recursive proofs", "[noir][consensus]") {
+  // Aunts as collected by the recursive trails of tendermint, from the leaf up
+  std::function<void(const bytes_list&, size_t, bytes_list&)> recursive_aunts = [&](const bytes_list& list,
+                                                                                   size_t index, bytes_list& aunts) {
+    if (list.size() <= 1)
+      return;
+    auto k = get_split_point(list.size());
+    bytes_list left{list.begin(), list.begin() + k}, right{list.begin() + k, list.end()};
+    if (index < k) {
+      recursive_aunts(left, index, aunts);
+      aunts.push_back(hash_from_bytes_list(right));
+    } else {
+      recursive_aunts(right, index - k, aunts);
+      aunts.push_back(hash_from_bytes_list(left));
+    }
+  };
+
+  bytes_list items;
+  for (auto i = 0; i < 17; i++) {
+    items.push_back(Bytes(std::vector<unsigned char>(i % 7 + 1, i)));
+    auto [root_hash, proofs] = proofs_from_bytes_list(items);
+    CHECK(root_hash == hash_from_bytes_list(items));
+    REQUIRE(proofs.size() == items.size());
+    for (auto j = 0; j < items.size(); j++) {
+      bytes_list aunts;
+      recursive_aunts(items, j, aunts);
+      CHECK(proofs[j]->index == j);
+      CHECK(proofs[j]->total == items.size());
+      CHECK(proofs[j]->leaf_hash == leaf_hash_opt(items[j]));
+      CHECK(proofs[j]->aunts == aunts);
+      CHECK(!proofs[j]->verify(root_hash, items[j]).has_value());
+    }
+  }
+}
+
 TEST_CASE("merkle_tree: Verify proof", "[noir][consensus]") {
   // Empty proof
   auto [root_hash, proofs] = proofs_from_bytes_list({});
@@ -4,37 +4,25 @@
 // SPDX-License-Identifier: AGPL-3.0-or-later
 //
 #include <noir/consensus/merkle/tree.h>
-#include <functional>
+#include <cstring>
 
 namespace noir::consensus::merkle {
 
-using hash_func = std::function<Bytes(std::span<const unsigned char>)>;
-hash_func hash = [](std::span<const unsigned char> in) {
-  return crypto::Sha256()(in); ///< use Sha256 for now; may use a different algorithm in the future
-};
+using hasher = crypto::Sha256Native; ///< use Sha256 for now; may use a different algorithm in the future
 
-const char leaf_prefix = '\x00';
-const char inner_prefix = '\x01';
+const unsigned char leaf_prefix = 0x00;
+const unsigned char inner_prefix = 0x01;
 
 Bytes get_empty_hash() {
-  return hash({});
+  return hasher().final();
 }
 
 Bytes leaf_hash_opt(const Bytes& leaf) {
-  Bytes buff;
-  buff.raw().reserve(leaf.size() + 1);
-  buff.raw().push_back(leaf_prefix);
-  buff.raw().insert(buff.end(), leaf.begin(), leaf.end());
-  return hash(buff);
+  return hasher().update(std::span(&leaf_prefix, 1)).update(leaf).final();
 }
 
 Bytes inner_hash_opt(const Bytes& left, const Bytes& right) {
-  Bytes buff;
-  buff.raw().reserve(left.size() + right.size() + 1);
-  buff.raw().push_back(inner_prefix);
-  buff.raw().insert(buff.end(), left.begin(), left.end());
-  buff.raw().insert(buff.end(), right.begin(), right.end());
-  return hash(buff);
+  return hasher().update(std::span(&inner_prefix, 1)).update(left).update(right).final();
 }
 
 size_t get_split_point(size_t length) {
@@ -46,45 +34,82 @@ size_t get_split_point(size_t length) {
   return k;
 }
 
+void leaf_hash_to(std::span<const unsigned char> leaf, node_hash& out) {
+  hasher().update(std::span(&leaf_prefix, 1)).update(leaf).final(out);
+}
+
+size_t hash_level(const node_hash* level, size_t n, node_hash* parents) {
+  auto num_parents = n / 2;
+  unsigned char in0[65], in1[65];
+  in0[0] = in1[0] = inner_prefix;
+  // children are copied out before parents are written, so that parents may overwrite the level
+  size_t i = 0;
+  for (; i + 1 < num_parents; i += 2) {
+    std::memcpy(in0 + 1, level[2 * i].data(), 64);
+    std::memcpy(in1 + 1, level[2 * i + 2].data(), 64);
+    hasher::hash2(in0, in1, parents[i], parents[i + 1]);
+  }
+  if (i < num_parents) {
+    std::memcpy(in0 + 1, level[2 * i].data(), 64);
+    hasher().update(std::span(in0)).final(parents[i]);
+  }
+  if (n % 2)
+    parents[num_parents] = level[n - 1];
+  return num_parents + n % 2;
+}
+
 Bytes hash_from_bytes_list(const bytes_list& list) {
-  switch (list.size()) {
-  case 0:
+  if (list.empty())
     return get_empty_hash();
-  case 1:
-    return leaf_hash_opt(list[0]);
-  }
-  auto k = get_split_point(list.size());
-  auto left = hash_from_bytes_list({list.begin(), list.begin() + k});
-  auto right = hash_from_bytes_list({list.begin() + k, list.end()});
-  return inner_hash_opt(left, right);
+
+  // Built bottom-up in a single buffer, which each level overwrites with its parents
+  std::vector<node_hash> level(list.size());
+  for (size_t i = 0; i < list.size(); i++)
+    leaf_hash_to(list[i], level[i]);
+  for (auto n = list.size(); n > 1;)
+    n = hash_level(level.data(), n, level.data());
+  return {level[0].begin(), level[0].end()};
 }
 
-Bytes compute_hash_from_aunts(int64_t index, int64_t total, Bytes leaf_hash, bytes_list inner_hashes) {
+Bytes compute_hash_from_aunts(
+  int64_t index, int64_t total, const Bytes& leaf_hash, std::span<const Bytes> inner_hashes) {
   if (index >= total || index < 0 || total <= 0)
     return {};
-  switch (total) {
-  case 0:
-    check(false, "cannot call compute_hash_from_aunts with 0 total");
-  case 1:
-    if (!inner_hashes.empty())
+
+  // Find the side of the path to the leaf at each depth, from the root
+  uint64_t is_right{0};
+  size_t depth{0};
+  for (; total > 1; depth++) {
+    if (depth == inner_hashes.size())
       return {};
-    return leaf_hash;
+    auto num_left = static_cast<int64_t>(get_split_point(total));
+    if (index < num_left) {
+      total = num_left;
+    } else {
+      index -= num_left;
+      total -= num_left;
+      is_right |= uint64_t{1} << depth;
+    }
   }
-  if (inner_hashes.empty())
+  if (depth != inner_hashes.size())
     return {};
-  auto num_left = get_split_point(total);
-  if (index < num_left) {
-    auto left_hash =
-      compute_hash_from_aunts(index, num_left, leaf_hash, {inner_hashes.begin(), inner_hashes.end() - 1});
-    if (left_hash.empty())
-      return {};
-    return inner_hash_opt(left_hash, inner_hashes[inner_hashes.size() - 1]);
+  if (depth == 0)
+    return leaf_hash;
+
+  // Hash up from the leaf; the first aunt is the sibling at the deepest level
+  node_hash hash;
+  std::span<const unsigned char> cur = leaf_hash;
+  for (size_t i = 0; i < depth; i++) {
+    hasher h;
+    h.update(std::span(&inner_prefix, 1));
+    if (is_right & (uint64_t{1} << (depth - 1 - i)))
+      h.update(inner_hashes[i]).update(cur);
+    else
+      h.update(cur).update(inner_hashes[i]);
+    h.final(hash);
+    cur = hash;
   }
-  auto right_hash = compute_hash_from_aunts(
-    index - num_left, total - num_left, leaf_hash, {inner_hashes.begin(), inner_hashes.end() - 1});
-  if (right_hash.empty())
-    return {};
-  return inner_hash_opt(inner_hashes[inner_hashes.size() - 1], right_hash);
+  return {hash.begin(), hash.end()};
 }
 
 } // namespace noir::consensus::merkle
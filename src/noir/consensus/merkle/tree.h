@@ -9,22 +9,42 @@
 #include <noir/common/hex.h>
 #include <noir/crypto/hash.h>
 
+#include <array>
 #include <bit>
+#include <span>
 
 namespace noir::consensus::merkle {
 
 using bytes_list = std::vector<Bytes>;
 
+/// \brief hash of a tree node
+using node_hash = std::array<unsigned char, 32>;
+
 Bytes get_empty_hash();
 
 Bytes leaf_hash_opt(const Bytes& leaf);
 
 Bytes inner_hash_opt(const Bytes& left, const Bytes& right);
 
+/// \brief computes the leaf hash of an item without allocating
+void leaf_hash_to(std::span<const unsigned char> leaf, node_hash& out);
+
+/// \brief computes the parents of a level of nodes
+/// Adjacent nodes are paired from the left and a last unpaired node moves up as is, which gives the same tree as
+/// splitting at get_split_point() recursively.
+/// \param[in] level nodes of the level
+/// \param[in] n number of nodes in the level
+/// \param[out] parents (n + 1) / 2 parents; may be the same buffer as level
+/// \return number of parents
+size_t hash_level(const node_hash* level, size_t n, node_hash* parents);
+
 size_t get_split_point(size_t length);
 
 Bytes hash_from_bytes_list(const bytes_list& list);
 
-Bytes compute_hash_from_aunts(int64_t index, int64_t total, Bytes leaf_hash, bytes_list inner_hashes);
+/// \brief computes the root hash from a leaf hash and its aunts, ordered from the bottom of the tree
+/// \return root hash, or empty if the number of aunts does not match the position of the leaf
+Bytes compute_hash_from_aunts(
+  int64_t index, int64_t total, const Bytes& leaf_hash, std::span<const Bytes> inner_hashes);
 
 } // namespace noir::consensus::merkle
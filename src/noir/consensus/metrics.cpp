@@ -0,0 +1,32 @@
+// This file is part of NOIR.
+//
+// Copyright (c) 2022 Haderech Pte. Ltd.
+// SPDX-License-Identifier: AGPL-3.0-or-later
+//
+#include <noir/consensus/metrics.h>
+
+namespace noir::consensus {
+
+void consensus_metrics::observe(const std::string& name, std::chrono::steady_clock::duration d) {
+  auto us = std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+  std::scoped_lock g(mtx);
+  latencies[name].record(us > 0 ? us : 0);
+}
+
+std::vector<latency_summary> consensus_metrics::summarize() const {
+  std::scoped_lock g(mtx);
+  std::vector<latency_summary> ret;
+  ret.reserve(latencies.size());
+  for (const auto& [name, h] : latencies) {
+    ret.push_back({name, h.count(), h.min(), static_cast<uint64_t>(h.mean()), h.value_at_quantile(0.5),
+      h.value_at_quantile(0.9), h.value_at_quantile(0.99), h.max()});
+  }
+  return ret;
+}
+
+void consensus_metrics::reset() {
+  std::scoped_lock g(mtx);
+  latencies.clear();
+}
+
+} // namespace noir::consensus
@@ -0,0 +1,55 @@
+// This file is part of NOIR.
+//
+// Copyright (c) 2022 Haderech Pte. Ltd.
+// SPDX-License-Identifier: AGPL-3.0-or-later
+//
+#pragma once
+#include <noir/common/histogram.h>
+#include <noir/common/refl.h>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace noir::consensus {
+
+/// \brief distribution of one consensus latency in microseconds
+struct latency_summary {
+  std::string name;
+  uint64_t count;
+  uint64_t min;
+  uint64_t mean;
+  uint64_t p50;
+  uint64_t p90;
+  uint64_t p99;
+  uint64_t max;
+};
+
+/// \brief latency histograms of consensus steps and events on the critical path of a height
+///
+/// Names recorded by consensus_state:
+/// - `step.<step>`: time spent in each round step, e.g. `step.Propose`
+/// - `round.first_block_part`, `round.last_block_part`: from the start of a round until the first and the last part
+///   of the proposal block is received
+/// - `round.prevote_maj23`, `round.precommit_maj23`: from the start of a round until +2/3 prevotes or precommits for a
+///   single block are received
+/// - `height`: from the start of a height until the height is committed
+/// - `wal_sync`, `apply_block`: duration of WAL syncs and of block execution
+class consensus_metrics {
+public:
+  void observe(const std::string& name, std::chrono::steady_clock::duration d);
+
+  /// \return summaries of all latencies recorded, ordered by name
+  std::vector<latency_summary> summarize() const;
+
+  void reset();
+
+private:
+  mutable std::mutex mtx;
+  std::map<std::string, histogram> latencies;
+};
+
+} // namespace noir::consensus
+
+NOIR_REFLECT(noir::consensus::latency_summary, name, count, min, mean, p50, p90, p99, max);
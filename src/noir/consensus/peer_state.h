@@ -7,18 +7,59 @@
 #include <noir/consensus/common.h>
 #include <noir/consensus/types/node_id.h>
 #include <noir/consensus/types/peer_round_state.h>
+#include <boost/asio/bind_executor.hpp>
+#include <boost/asio/steady_timer.hpp>
 
+#include <atomic>
 #include <utility>
 
 namespace noir::consensus {
 
+/// \brief parks a per-peer gossip routine until it is woken up or a timeout expires, without blocking a thread
+/// All member functions must be called from the strand of the peer.
+class gossip_timer {
+public:
+  explicit gossip_timer(boost::asio::io_context::strand& strand): strand(strand), timer(strand.context()) {}
+
+  /// \brief calls `f` on the strand after `timeout`, or as soon as wake() is called
+  template<typename F>
+  void wait(std::chrono::nanoseconds timeout, F&& f) {
+    if (woken) {
+      // woken while the routine was running; there may be something new to send
+      woken = false;
+      boost::asio::post(strand, std::forward<F>(f));
+      return;
+    }
+    timer.expires_after(timeout);
+    timer.async_wait(boost::asio::bind_executor(strand, [this, f{std::forward<F>(f)}](const auto&) mutable {
+      woken = false;
+      f();
+    }));
+  }
+
+  /// \brief resumes the parked routine, or makes its next wait() return immediately
+  void wake() {
+    woken = true;
+    timer.cancel();
+  }
+
+private:
+  boost::asio::io_context::strand& strand;
+  boost::asio::steady_timer timer;
+  bool woken{};
+};
+
 struct peer_state {
   std::string peer_id;
 
-  bool is_running{};
+  std::atomic_bool is_running{};
   peer_round_state prs;
   std::mutex mtx;
   std::shared_ptr<boost::asio::io_context::strand> strand;
+  std::unique_ptr<gossip_timer> data_timer;
+  std::unique_ptr<gossip_timer> votes_timer;
+  std::unique_ptr<gossip_timer> query_maj23_timer;
+  std::atomic_bool wake_pending{}; ///< a wake-up of the gossip timers is queued on the strand
 
   static std::shared_ptr<peer_state> new_peer_state(const std::string& peer_id_, boost::asio::io_context& ioc) {
     auto ret = std::make_shared<peer_state>();
@@ -28,6 +69,9 @@ struct peer_state {
     ret->prs.last_commit_round = -1;
     ret->prs.catchup_commit_round = -1;
     ret->strand = std::make_shared<boost::asio::io_context::strand>(ioc);
+    ret->data_timer = std::make_unique<gossip_timer>(*ret->strand);
+    ret->votes_timer = std::make_unique<gossip_timer>(*ret->strand);
+    ret->query_maj23_timer = std::make_unique<gossip_timer>(*ret->strand);
     return ret;
   }
 
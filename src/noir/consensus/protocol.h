@@ -11,7 +11,8 @@ namespace noir::consensus {
 enum event_type {
   EventNewRoundStep = 1,
   EventValidBlock,
-  EventVote
+  EventVote,
+  EventProposalData ///< a proposal or a proposal block part was added; only wakes up gossip
 };
 
 struct timeout_info {
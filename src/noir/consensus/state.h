@@ -116,7 +116,7 @@ struct state {
       if (commit_sig.absent())
         continue;
       auto validator = validators->get_by_address(commit_sig.validator_address);
-      if (validator.has_value()) {
+      if (validator) {
         total_voting_power += validator->voting_power;
         weighted_times.push_back(weighted_time{commit_sig.timestamp, validator->voting_power});
       }
@@ -107,21 +107,19 @@ public:
       return false;
     }
     auto parts_total = bl_meta.bl_id.parts.total;
-    part part_{};
-    Bytes data{};
+    std::vector<part> parts(parts_total);
+    std::vector<std::span<const unsigned char>> data;
+    data.reserve(parts_total);
     for (auto i = 0; i < parts_total; ++i) {
       // If the part is missing (e.g. since it has been deleted after we
       // loaded the block meta) we consider the whole block to be missing.
-      if (!load_block_part(height_, i, part_)) {
+      if (!load_block_part(height_, i, parts[i])) {
         return false;
       }
-      data.raw().insert(data.end(), part_.bytes_.begin(), part_.bytes_.end());
+      data.emplace_back(parts[i].bytes_.data(), parts[i].bytes_.size());
     }
-    // bl = decode<block>(data);
     // Note : data is always serialized using protobuf via block::make_part_set
-    ::tendermint::types::Block pb;
-    pb.ParseFromArray(data.data(), data.size());
-    bl = *block::from_proto(pb);
+    bl = *block::new_block_from_parts(std::move(data));
     return true;
   }
 
@@ -230,7 +230,7 @@ private:
     auto height = st.last_block_height + 1;
     if (height == 1) {
       height = st.initial_height;
-    } else if (st.last_validators && !st.last_validators->validators.empty()) { // height > 1, can height < 0 ?
+    } else if (st.last_validators && st.last_validators->size() > 0) { // height > 1, can height < 0 ?
       if (!save_validators_info(height - 1, height - 1, st.last_validators, batch)) {
         return false;
       }
@@ -268,7 +268,7 @@ private:
     if (height == last_height_changed || height % val_set_checkpoint_interval == 0) {
       if (!v_set)
         val_info.mutable_validator_set(); // set empty validator_set
-      else if (!v_set->validators.empty())
+      else if (v_set->size() > 0)
         val_info.set_allocated_validator_set(validator_set::to_proto(v_set).release());
     }
     Bytes bz(val_info.ByteSizeLong());
@@ -41,15 +41,15 @@ TEST_CASE("db_store: save/load validator_set", "[noir][consensus]") {
 
   CHECK(dbs.save_validator_sets(1, 2, v_set) == true);
   CHECK(dbs.load_validators(1, ret) == true);
-  CHECK(v_set->validators[0].address == ret->validators[0].address);
-  CHECK(v_set->validators[0].pub_key_.key == ret->validators[0].pub_key_.key);
-  CHECK(v_set->validators[0].voting_power == ret->validators[0].voting_power);
-  CHECK(v_set->validators[0].proposer_priority == ret->validators[0].proposer_priority);
+  CHECK(v_set->get_validators()[0].address == ret->get_validators()[0].address);
+  CHECK(v_set->get_validators()[0].pub_key_.key == ret->get_validators()[0].pub_key_.key);
+  CHECK(v_set->get_validators()[0].voting_power == ret->get_validators()[0].voting_power);
+  CHECK(v_set->get_validators()[0].proposer_priority == ret->get_validators()[0].proposer_priority);
   CHECK(dbs.load_validators(2, ret) == true);
-  CHECK(v_set->validators[0].address == ret->validators[0].address);
-  CHECK(v_set->validators[0].pub_key_.key == ret->validators[0].pub_key_.key);
-  CHECK(v_set->validators[0].voting_power == ret->validators[0].voting_power);
-  CHECK(v_set->validators[0].proposer_priority == ret->validators[0].proposer_priority);
+  CHECK(v_set->get_validators()[0].address == ret->get_validators()[0].address);
+  CHECK(v_set->get_validators()[0].pub_key_.key == ret->get_validators()[0].pub_key_.key);
+  CHECK(v_set->get_validators()[0].voting_power == ret->get_validators()[0].voting_power);
+  CHECK(v_set->get_validators()[0].proposer_priority == ret->get_validators()[0].proposer_priority);
 }
 
 TEST_CASE("db_store: save/load consensus_param", "[noir][consensus]") {
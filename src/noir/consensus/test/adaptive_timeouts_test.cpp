@@ -0,0 +1,64 @@
+// This file is part of NOIR.
+//
+// Copyright (c) 2022 Haderech Pte. Ltd.
+// SPDX-License-Identifier: AGPL-3.0-or-later
+//
+#include <catch2/catch_all.hpp>
+#include <noir/consensus/adaptive_timeouts.h>
+
+using namespace noir;
+using namespace noir::consensus;
+using namespace std::chrono_literals;
+
+TEST_CASE("adaptive_timeouts: timeouts follow observed latencies", "[noir][consensus]") {
+  auto cfg = consensus_config::get_default();
+  cfg.adaptive_timeouts = true;
+  cfg.timeout_adaptive_min = 100ms;
+  cfg.timeout_adaptive_max = 2000ms;
+  cfg.timeout_adaptive_margin = 50ms;
+  cfg.timeout_adaptive_percentile = 90;
+
+  adaptive_timeouts timeouts;
+  auto t0 = adaptive_timeouts::clock::time_point{} + 1h;
+
+  SECTION("static until sampled") {
+    CHECK(timeouts.propose(cfg, 0) == cfg.propose(0));
+    CHECK(timeouts.prevote(cfg, 2) == cfg.prevote(2));
+    CHECK(timeouts.precommit(cfg, 1) == cfg.precommit(1));
+  }
+
+  SECTION("percentile plus margin") {
+    for (int64_t h = 1; h <= 10; h++) {
+      timeouts.enter_step(h, 0, p2p::round_step_type::Propose, t0);
+      timeouts.complete_proposal(h, 0, t0 + std::chrono::milliseconds{h * 100});
+      // later completions in the same height are ignored
+      timeouts.complete_proposal(h, 0, t0 + 10s);
+    }
+    CHECK(timeouts.propose(cfg, 0) == 950ms);
+    CHECK(timeouts.propose(cfg, 2) == 950ms + 2 * cfg.timeout_propose_delta);
+  }
+
+  SECTION("bounded") {
+    timeouts.enter_step(1, 0, p2p::round_step_type::Prevote, t0);
+    timeouts.reach_quorum(1, 0, p2p::Prevote, t0 + 1ms);
+    CHECK(timeouts.prevote(cfg, 0) == 100ms);
+
+    timeouts.enter_step(1, 0, p2p::round_step_type::Precommit, t0);
+    timeouts.reach_quorum(1, 0, p2p::Precommit, t0 + 1min);
+    CHECK(timeouts.precommit(cfg, 0) == 2000ms);
+  }
+
+  SECTION("only samples the round whose step was entered") {
+    timeouts.enter_step(1, 0, p2p::round_step_type::Prevote, t0);
+    timeouts.reach_quorum(1, 1, p2p::Prevote, t0 + 1ms);
+    timeouts.reach_quorum(2, 0, p2p::Prevote, t0 + 1ms);
+    CHECK(timeouts.prevote(cfg, 0) == cfg.prevote(0));
+  }
+
+  SECTION("disabled") {
+    cfg.adaptive_timeouts = false;
+    timeouts.enter_step(1, 0, p2p::round_step_type::Propose, t0);
+    timeouts.complete_proposal(1, 0, t0 + 1ms);
+    CHECK(timeouts.propose(cfg, 0) == cfg.propose(0));
+  }
+}
@@ -7,6 +7,7 @@
 #include <noir/common/hex.h>
 #include <noir/consensus/bit_array.h>
 #include <noir/core/codec.h>
+#include <set>
 
 using namespace noir;
 using namespace noir::consensus;
@@ -206,3 +207,31 @@ TEST_CASE("bit_array: serialization", "[noir][consensus]") {
     CHECK(ba->string() == restored->string());
   }
 }
+
+TEST_CASE("bit_array: pick_random", "[noir][consensus]") {
+  auto ba = bit_array::new_bit_array(200);
+  CHECK(std::get<1>(ba->pick_random()) == false);
+
+  std::set<int> expected{3, 64, 127, 130, 199};
+  for (auto i : expected)
+    ba->set_index(i, true);
+  CHECK(ba->get_true_indices() == std::vector<int>(expected.begin(), expected.end()));
+
+  std::set<int> picked;
+  for (auto i = 0; i < 1000; i++) {
+    auto [index, ok] = ba->pick_random();
+    REQUIRE(ok);
+    CHECK(expected.contains(index));
+    picked.insert(index);
+  }
+  CHECK(picked == expected);
+
+  // tail bits stay clear after not_op
+  auto nb = bit_array::new_bit_array(70)->not_op();
+  CHECK(nb->get_true_indices().size() == 70);
+  CHECK(bit_array::to_proto(*nb)->elems(1) == 0x3f);
+
+  // static copy keeps the bits
+  auto cb = bit_array::copy(ba);
+  CHECK(cb->string() == ba->string());
+}
@@ -57,3 +57,66 @@ TEST_CASE("block_executor: Apply block", "[noir][consensus]") {
 
   CHECK(block_exec->apply_block(state_, block_id_, block_) != std::nullopt);
 }
+
+TEST_CASE("block_executor: Optimistic execution", "[noir][consensus]") {
+  struct counting_app : application::base_application {
+    std::atomic<int> begin_blocks{0};
+    int rollbacks{0};
+    std::unique_ptr<tendermint::abci::ResponseBeginBlock> begin_block(
+      const tendermint::abci::RequestBeginBlock& req) override {
+      begin_blocks++;
+      return {};
+    }
+    bool supports_rollback() const override {
+      return true;
+    }
+    void rollback() override {
+      rollbacks++;
+    }
+  };
+
+  auto [state_, state_db, priv_vals, session] = make_state(1, 1);
+
+  auto app_ = std::make_shared<counting_app>();
+  auto proxyApp = std::make_shared<app_connection>();
+  proxyApp->application = app_;
+  auto bls = std::make_shared<noir::consensus::block_store>(session);
+  auto ev_bus = std::make_shared<noir::consensus::events::event_bus>(app);
+  auto ev_pool = std::make_shared<ev::empty_evidence_pool>();
+  auto block_exec = block_executor::new_block_executor(state_db, proxyApp, ev_pool, bls, ev_bus);
+
+  auto block_ = ev::make_block(1, state_, std::make_shared<commit>());
+  auto block_id_ = p2p::block_id{block_->get_hash(), block_->make_part_set(65536)->header()};
+
+  SECTION("same block is committed") {
+    CHECK(block_exec->exec_block_optimistically(state_, block_));
+    CHECK(block_exec->apply_block(state_, block_id_, block_) != std::nullopt);
+    CHECK(app_->begin_blocks == 1);
+    CHECK(app_->rollbacks == 0);
+  }
+
+  SECTION("other block is committed") {
+    std::vector<Bytes> txs{Bytes{"01"}};
+    auto [other_block, _] = state_.make_block(1, txs, std::make_shared<commit>(), {}, {});
+    other_block->header.height = 1;
+    REQUIRE(other_block->get_hash() != block_->get_hash());
+
+    CHECK(block_exec->exec_block_optimistically(state_, other_block));
+    CHECK(block_exec->apply_block(state_, block_id_, block_) != std::nullopt);
+    CHECK(app_->begin_blocks == 2);
+    CHECK(app_->rollbacks == 1);
+  }
+
+  SECTION("proposal changes while executing") {
+    std::vector<Bytes> txs{Bytes{"01"}};
+    auto [other_block, _] = state_.make_block(1, txs, std::make_shared<commit>(), {}, {});
+    other_block->header.height = 1;
+
+    // the second execution rolls back the first on the exec thread, without waiting for it here
+    CHECK(block_exec->exec_block_optimistically(state_, other_block));
+    CHECK(block_exec->exec_block_optimistically(state_, block_));
+    CHECK(block_exec->apply_block(state_, block_id_, block_) != std::nullopt);
+    CHECK(app_->begin_blocks == 2);
+    CHECK(app_->rollbacks == 1);
+  }
+}
@@ -101,6 +101,27 @@ TEST_CASE("consensus_state: Verify vote signature", "[noir][consensus]") {
   CHECK(result == true);
 }
 
+TEST_CASE("consensus_state: Prepared proposal", "[noir][consensus]") {
+  auto local_config = config_setup();
+  auto [cs1, vss] = rand_cs(local_config, 1);
+
+  SECTION("up to date") {
+    cs1->prepare_proposal();
+    auto prepared = cs1->take_prepared_proposal();
+    REQUIRE(prepared.has_value());
+    CHECK(std::get<0>(prepared.value())->header.height == cs1->rs.height);
+  }
+
+  SECTION("pending evidence replaced") {
+    cs1->prepare_proposal();
+    // as if one pending evidence was committed and another one arrived, leaving the count unchanged
+    auto size = cs1->ev_pool->get_size();
+    cs1->ev_pool->evidence_version++;
+    CHECK(cs1->ev_pool->get_size() == size);
+    CHECK(!cs1->take_prepared_proposal().has_value());
+  }
+}
+
 TEST_CASE("consensus_state: Test State Full Round1", "[noir][consensus]") {
   appbase::application app_;
   app_.register_plugin<test_plugin>();
@@ -156,3 +177,63 @@ TEST_CASE("consensus_state: Test State Full Round1", "[noir][consensus]") {
 
   app_.quit();
 }
+
+TEST_CASE("consensus_state: metrics", "[noir][consensus]") {
+  appbase::application app_;
+  app_.register_plugin<test_plugin>();
+  app_.initialize<test_plugin>();
+
+  auto local_config = config_setup();
+  constexpr int timeout_new_round = 3;
+  constexpr int timeout_propose = 3;
+  constexpr int timeout_prevote = 1;
+  constexpr int timeout_precommit = 1;
+  constexpr int timeout_commit = 3;
+  constexpr int timeout_delta = 1;
+
+  local_config.consensus.timeout_propose = std::chrono::seconds{timeout_propose};
+  local_config.consensus.timeout_prevote = std::chrono::seconds{timeout_prevote};
+  local_config.consensus.timeout_precommit = std::chrono::seconds{timeout_precommit};
+  local_config.consensus.timeout_commit = std::chrono::seconds{timeout_commit};
+
+  auto [cs1, vss] = rand_cs(local_config, 1, app_);
+  auto cs_monitor = status_monitor("test", cs1->event_bus_, cs1);
+  auto height = cs1->rs.height;
+  auto round = cs1->rs.round;
+
+  auto thread = std::make_unique<noir::named_thread_pool>("test_thread", 5);
+  auto res = noir::async_thread_pool(thread->get_executor(), [&]() {
+    app_.startup();
+    app_.exec();
+  });
+
+  cs_monitor.subscribe_filtered_msg([](const events::message& msg) {
+    return static_cast<int>(msg.data.index()) == status_monitor::get_message_type_index<events::event_data_new_round>();
+  });
+  cs1->metrics.reset();
+  start_test_round(cs1, height, round);
+
+  CHECK(cs_monitor.ensure_new_round(timeout_new_round + timeout_delta, height, round) == true);
+  CHECK(cs_monitor.ensure_new_round(timeout_commit + timeout_propose + timeout_delta, height + 1, 0) == true);
+
+  std::map<std::string, latency_summary> summaries;
+  for (auto& summary : cs1->metrics.summarize()) {
+    CHECK(summary.count > 0);
+    CHECK(summary.min <= summary.p50);
+    CHECK(summary.p50 <= summary.p90);
+    CHECK(summary.p90 <= summary.p99);
+    CHECK(summary.p99 <= summary.max);
+    summaries.emplace(summary.name, summary);
+  }
+  for (const auto* name : {"step.NewRound", "step.Propose", "step.Prevote", "step.Precommit", "round.last_block_part",
+         "round.prevote_maj23", "round.precommit_maj23", "wal_sync", "apply_block"}) {
+    INFO(name);
+    CHECK(summaries.contains(name));
+  }
+  CHECK(summaries["apply_block"].count == 1);
+
+  cs1->metrics.reset();
+  CHECK(cs1->metrics.summarize().empty());
+
+  app_.quit();
+}
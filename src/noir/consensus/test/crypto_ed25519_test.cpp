@@ -6,7 +6,9 @@
 #include <catch2/catch_all.hpp>
 #include <noir/common/hex.h>
 #include <noir/consensus/crypto.h>
+#include <noir/consensus/ed25519.h>
 #include <cppcodec/base64_default_rfc4648.hpp>
+#include <thread>
 
 extern "C" {
 #include <sodium.h>
@@ -38,3 +40,125 @@ TEST_CASE("crypto: encode keys", "[noir][consensus]") {
   CHECK(base64::encode(pub_key_.key.data(), pub_key_.key.size()) == "tb5rjQ6RNY9zg96Fww9opbrSc6/fqVOSTbXpT2Cgt8g=");
   CHECK(addr == "BEB5FACCA0E17CF6C63DED5475A6E266120E692A");
 }
+
+TEST_CASE("crypto: batch verify ed25519", "[noir][consensus]") {
+  batch_verifier bv;
+  CHECK(bv.verify().first);
+
+  auto num_sigs = GENERATE(4, 64);
+  auto bad_index = num_sigs / 2;
+  for (auto i = 0; i < num_sigs; i++) {
+    auto priv_key_ = priv_key::new_priv_key();
+    Bytes msg(8);
+    msg[0] = static_cast<unsigned char>(i);
+    auto sig = priv_key_.sign(msg);
+    bv.add(priv_key_.get_pub_key(), msg, sig);
+  }
+  CHECK(bv.size() == num_sigs);
+  CHECK(bv.verify().first);
+
+  auto priv_key_ = priv_key::new_priv_key();
+  auto sig = priv_key_.sign(from_hex("0123"));
+  batch_verifier bad;
+  for (auto i = 0; i < num_sigs; i++) {
+    bad.add(priv_key_.get_pub_key(), from_hex(i == bad_index ? "abcd" : "0123"), sig);
+  }
+  auto [ok, valid_sigs] = bad.verify();
+  CHECK(!ok);
+  REQUIRE(valid_sigs.size() == num_sigs);
+  for (auto i = 0; i < num_sigs; i++) {
+    CHECK(valid_sigs[i] == (i != bad_index));
+  }
+
+  // a failed batch verified on every pool thread at once must not wait for the pool
+  std::vector<std::future<bool>> results;
+  for (auto i = 0u; i < std::max(1u, std::thread::hardware_concurrency()); i++) {
+    results.push_back(async_thread_pool(verifier_pool().get_executor(), [&bad]() { return bad.verify().first; }));
+  }
+  for (auto& r : results) {
+    CHECK(!r.get());
+  }
+}
+
+TEST_CASE("crypto: ed25519 verify_batch", "[noir][consensus]") {
+  std::vector<Bytes> keys, msgs, sigs;
+  for (auto i = 0; i < 8; i++) {
+    auto priv_key_ = priv_key::new_priv_key();
+    keys.push_back(priv_key_.get_pub_key().key);
+    msgs.push_back(Bytes(std::vector<unsigned char>(i + 1, i)));
+    sigs.push_back(priv_key_.sign(msgs.back()));
+  }
+  auto verify_batch = [&]() {
+    std::vector<ed25519::signed_message> batch;
+    for (auto i = 0; i < keys.size(); i++)
+      batch.push_back({{keys[i].data(), 32}, {msgs[i].data(), msgs[i].size()}, {sigs[i].data(), sigs[i].size()}});
+    return ed25519::verify_batch(batch);
+  };
+  CHECK(verify_batch());
+
+  SECTION("wrong message") {
+    msgs[3][0] ^= 1;
+    CHECK(!verify_batch());
+  }
+  SECTION("wrong key") {
+    std::swap(keys[2], keys[5]);
+    CHECK(!verify_batch());
+  }
+  SECTION("small order R") {
+    std::fill(sigs[4].begin(), sigs[4].begin() + 32, 0);
+    sigs[4][0] = 1;
+    CHECK(!verify_batch());
+  }
+  SECTION("non-canonical s") {
+    // s + L satisfies the equation as well, but is rejected like crypto_sign_verify_detached does
+    auto order = from_hex("edd3f55c1a631258d69cf7a2def9de1400000000000000000000000000000010");
+    unsigned carry = 0;
+    for (auto i = 0; i < 32; i++) {
+      carry += sigs[6][32 + i] + order[i];
+      sigs[6][32 + i] = static_cast<unsigned char>(carry);
+      carry >>= 8;
+    }
+    CHECK(!verify_batch());
+  }
+}
+
+TEST_CASE("crypto: signature cache", "[noir][consensus]") {
+  auto priv_key_ = priv_key::new_priv_key();
+  auto pub_key_ = priv_key_.get_pub_key();
+  auto msg = from_hex("0123");
+  auto sig = priv_key_.sign(msg);
+
+  SECTION("verify_signature") {
+    auto& cache = signature_cache::instance();
+    auto hits = cache.hits();
+    auto misses = cache.misses();
+    CHECK(pub_key_.verify_signature(msg, sig));
+    CHECK(cache.misses() == misses + 1);
+    CHECK(pub_key_.verify_signature(msg, sig));
+    CHECK(cache.hits() == hits + 1);
+
+    // failed verifications are not cached
+    CHECK(!pub_key_.verify_signature(from_hex("abcd"), sig));
+    CHECK(!pub_key_.verify_signature(from_hex("abcd"), sig));
+    CHECK(cache.hits() == hits + 1);
+  }
+
+  SECTION("eviction") {
+    signature_cache cache(signature_cache::num_shards);
+    std::vector<Bytes> digests;
+    for (auto i = 0; i < 64; i++) {
+      Bytes m(1);
+      m[0] = static_cast<unsigned char>(i);
+      digests.push_back(signature_cache::digest(pub_key_.key, m, sig));
+      cache.add(digests.back());
+    }
+    CHECK(cache.size() <= signature_cache::num_shards);
+    CHECK(cache.contains(digests.back()));
+    CHECK(cache.hits() == 1);
+
+    cache.clear();
+    CHECK(cache.size() == 0);
+    CHECK(!cache.contains(digests.back()));
+    CHECK(cache.misses() == 1);
+  }
+}
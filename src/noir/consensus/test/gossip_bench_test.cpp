@@ -0,0 +1,108 @@
+// This file is part of NOIR.
+//
+// Copyright (c) 2022 Haderech Pte. Ltd.
+// SPDX-License-Identifier: AGPL-3.0-or-later
+//
+#include <catch2/catch_all.hpp>
+#include <noir/common/thread_pool.h>
+#include <noir/consensus/peer_state.h>
+#include <thread>
+
+namespace {
+
+using namespace noir;
+using namespace noir::consensus;
+using namespace std::chrono_literals;
+
+// Simulates gossip_votes_routine of `num_peers` peers on the gossip thread pool. Each peer sends the latest vote once;
+// a round of the benchmark publishes a new vote and measures how long it takes until every peer has sent it.
+struct simulated_gossip {
+  static constexpr size_t num_peers = 50;
+  static constexpr size_t thread_pool_size = 5;
+
+  named_thread_pool thread_pool{"gossip", thread_pool_size};
+  std::vector<std::shared_ptr<peer_state>> peers;
+  std::atomic<int64_t> latest_vote{0};
+  std::vector<int64_t> sent_vote = std::vector<int64_t>(num_peers, 0);
+  std::atomic<size_t> num_sent{0};
+
+  simulated_gossip() {
+    for (size_t i = 0; i < num_peers; i++) {
+      peers.push_back(peer_state::new_peer_state(std::to_string(i), thread_pool.get_executor()));
+      peers.back()->is_running = true;
+    }
+  }
+
+  ~simulated_gossip() {
+    for (auto& ps : peers)
+      ps->is_running = false;
+    thread_pool.stop();
+  }
+
+  // returns false if there was nothing to send
+  bool send_vote(size_t i) {
+    auto vote = latest_vote.load();
+    if (sent_vote[i] == vote)
+      return false;
+    sent_vote[i] = vote;
+    num_sent++;
+    return true;
+  }
+
+  void event_driven_routine(size_t i) {
+    auto& ps = peers[i];
+    ps->strand->post([this, i, ps]() {
+      if (!ps->is_running)
+        return;
+      if (send_vote(i))
+        event_driven_routine(i);
+      else
+        ps->votes_timer->wait(100ms, [this, i]() { event_driven_routine(i); });
+    });
+  }
+
+  void sleeping_routine(size_t i, std::chrono::milliseconds sleep_duration) {
+    auto& ps = peers[i];
+    ps->strand->post([this, i, ps, sleep_duration]() {
+      if (!ps->is_running)
+        return;
+      if (!send_vote(i))
+        std::this_thread::sleep_for(sleep_duration);
+      sleeping_routine(i, sleep_duration);
+    });
+  }
+
+  void publish_vote(bool wake) {
+    num_sent = 0;
+    latest_vote++;
+    if (wake) {
+      for (auto& ps : peers)
+        ps->strand->post([ps]() { ps->votes_timer->wake(); });
+    }
+    while (num_sent < num_peers)
+      std::this_thread::yield();
+  }
+};
+
+} // namespace
+
+TEST_CASE("GossipBenchmarks", "[noir][consensus]") {
+  SECTION("event driven") {
+    simulated_gossip gossip;
+    for (size_t i = 0; i < simulated_gossip::num_peers; i++)
+      gossip.event_driven_routine(i);
+    BENCHMARK("VotePropagationEventDriven") {
+      gossip.publish_vote(true);
+    };
+  }
+
+  SECTION("sleep_for") {
+    // The former loop with a shortened sleep (default peer_gossip_sleep_duration is 100ms) to keep the run short
+    simulated_gossip gossip;
+    for (size_t i = 0; i < simulated_gossip::num_peers; i++)
+      gossip.sleeping_routine(i, 10ms);
+    BENCHMARK("VotePropagationSleep10ms") {
+      gossip.publish_vote(false);
+    };
+  }
+}
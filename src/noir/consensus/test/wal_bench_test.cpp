@@ -0,0 +1,59 @@
+// This file is part of NOIR.
+//
+// Copyright (c) 2022 Haderech Pte. Ltd.
+// SPDX-License-Identifier: AGPL-3.0-or-later
+//
+#include <catch2/catch_all.hpp>
+#include <noir/common/helper/go.h>
+#include <noir/consensus/wal.h>
+#include <noir/crypto/rand.h>
+#include <thread>
+
+namespace {
+
+using namespace noir::consensus;
+
+// Each round pushes `num_msgs` vote-sized messages through write_sync from `num_writers` threads, mimicking
+// concurrent peer message intake. Divide num_writers * num_msgs by the reported mean to get messages/sec.
+void write_sync_concurrently(base_wal& wal, size_t num_writers, size_t num_msgs) {
+  noir::Bytes payload(128);
+  noir::crypto::rand_bytes(payload);
+  wal_message msg{noir::p2p::internal_msg_info{
+    .msg = noir::p2p::block_part_message{.height = 1, .round = 0, .index = 0, .bytes_ = payload}, .peer_id = "peer"}};
+
+  std::vector<std::thread> writers;
+  for (size_t i = 0; i < num_writers; ++i) {
+    writers.emplace_back([&]() {
+      for (size_t j = 0; j < num_msgs; ++j) {
+        wal.write_sync(msg);
+      }
+    });
+  }
+  for (auto& w : writers) {
+    w.join();
+  }
+}
+
+TEST_CASE("WalBenchmarks", "[noir][consensus]") {
+  static constexpr size_t num_writers = 8;
+  static constexpr size_t num_msgs = 64;
+  static constexpr size_t rotate_size = 16 * 1024 * 1024;
+
+  auto modes = std::to_array<std::pair<wal_sync_mode, std::string>>({
+    {wal_sync_mode::immediate, "immediate"},
+    {wal_sync_mode::group_commit, "group_commit"},
+    {wal_sync_mode::async_writer, "async_writer"},
+  });
+  for (const auto& [mode, name] : modes) {
+    fc::temp_directory temp_dir;
+    base_wal wal_(temp_dir.path().string(), "wal", 5, rotate_size, mode);
+    wal_.on_start();
+    noir_defer([&]() { wal_.on_stop(); });
+
+    BENCHMARK(fmt::format("write_sync {} writers x {} msgs, mode={}", num_writers, num_msgs, name)) {
+      write_sync_concurrently(wal_, num_writers, num_msgs);
+    };
+  }
+}
+
+} // namespace
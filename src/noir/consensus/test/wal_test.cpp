@@ -16,7 +16,8 @@ namespace fs = std::filesystem;
 int count_dir(const std::string& tmp_path) {
   int cnt = 0;
   for (auto it = fs::directory_iterator(tmp_path); it != fs::directory_iterator(); ++it) {
-    if (fs::is_regular_file(*it)) {
+    // counts wal files only; the height index sidecar is not a wal file
+    if (fs::is_regular_file(*it) && !it->path().string().ends_with(wal_file_manager::index_postfix)) {
       ++cnt;
     }
   }
@@ -219,6 +220,52 @@ TEST_CASE("wal_codec: simple encode/decode", "[noir][consensus]") {
   }
 }
 
+TEST_CASE("wal_codec: frame checksum", "[noir][consensus]") {
+  auto temp_dir = std::make_shared<fc::temp_directory>();
+  auto wal_path = (temp_dir->path() / "wal").string();
+
+  std::array<unsigned char, wal_frame_header_size> hdr;
+  encode_wal_frame_header(hdr, 0x11223344, 0x55667788);
+  CHECK(hdr == std::array<unsigned char, wal_frame_header_size>{0x44, 0x33, 0x22, 0x11, 0x88, 0x77, 0x66, 0x55});
+  CHECK(decode_wal_frame_header(hdr) == std::pair<uint32_t, uint32_t>{0x11223344, 0x55667788});
+
+  size_t len;
+  {
+    wal_encoder enc{wal_path};
+    CHECK(enc.encode(timed_wal_message{.time = 1, .msg = {end_height_message{1}}}, len) == true);
+    CHECK(enc.encode(timed_wal_message{.time = 2, .msg = {end_height_message{2}}}, len) == true);
+    CHECK(enc.flush_and_sync() == true);
+  }
+
+  SECTION("intact") {
+    wal_decoder dec{wal_path};
+    timed_wal_message msg{};
+    CHECK(dec.decode(msg) == wal_decoder::result::success);
+    CHECK(msg.time == 1);
+    CHECK(dec.decode(msg) == wal_decoder::result::success);
+    CHECK(msg.time == 2);
+    CHECK(dec.decode(msg) == wal_decoder::result::eof);
+  }
+
+  SECTION("corrupted body") {
+    {
+      fc::cfile file;
+      file.set_file_path(wal_path);
+      file.open(fc::cfile::update_rw_mode);
+      file.seek(wal_frame_header_size);
+      char c = 0x7f;
+      file.write(&c, 1);
+      file.flush();
+    }
+    wal_decoder dec{wal_path};
+    timed_wal_message msg{};
+    CHECK(dec.decode(msg) == wal_decoder::result::corrupted);
+    // decoding continues with the next frame
+    CHECK(dec.decode(msg) == wal_decoder::result::success);
+    CHECK(msg.time == 2);
+  }
+}
+
 inline noir::Bytes gen_random_bytes(size_t num) {
   noir::Bytes ret(num);
   noir::crypto::rand_bytes(ret);
@@ -331,4 +378,139 @@ TEST_CASE("basic_wal: basic_wal test", "[noir][consensus]") {
   }
 }
 
+TEST_CASE("basic_wal: height index", "[noir][consensus]") {
+  static constexpr size_t enc_size = 4096;
+  static constexpr size_t rotation_file_num = 5;
+  static constexpr int64_t max_height = 30;
+  auto temp_dir = std::make_shared<fc::temp_directory>();
+  auto tmp_path = temp_dir->path().string();
+  auto index_path = (fs::path(tmp_path) / "wal").string() + std::string(wal_file_manager::index_postfix);
+
+  auto write_heights = [](base_wal& wal_) {
+    for (int64_t height = 1; height <= max_height; ++height) {
+      for (uint32_t index = 1; index < 10; ++index) {
+        noir::p2p::block_part_message bp_msg{
+          .height = height,
+          .round = 1,
+          .index = index,
+          .bytes_ = gen_random_bytes(32),
+          .proof{.leaf_hash = gen_random_bytes(32)},
+        };
+        CHECK(wal_.write({noir::p2p::internal_msg_info{.msg = bp_msg}}) == true);
+      }
+      CHECK(wal_.write({noir::consensus::end_height_message{height}}) == true);
+    }
+    CHECK(wal_.flush_and_sync() == true);
+  };
+  auto check_heights = [](base_wal& wal_) {
+    bool deleted = false;
+    for (int64_t height = max_height; height > 0; --height) {
+      bool found;
+      auto dec = wal_.search_for_end_height(height, {.ignore_data_corruption_errors = false}, found);
+      if (deleted) {
+        CHECK(found == false);
+      }
+      if (!found) {
+        deleted = true;
+        CHECK(dec == nullptr);
+        continue;
+      }
+      REQUIRE(dec != nullptr);
+      timed_wal_message msg{};
+      auto ret = dec->decode(msg);
+      if (height == max_height) {
+        CHECK(ret == wal_decoder::result::eof);
+        continue;
+      }
+      REQUIRE(ret == wal_decoder::result::success);
+      auto* msg_body = get_if<noir::p2p::internal_msg_info>(&msg.msg.msg);
+      REQUIRE(msg_body != nullptr);
+      auto* bp_msg = get_if<noir::p2p::block_part_message>(&msg_body->msg);
+      REQUIRE(bp_msg != nullptr);
+      CHECK(bp_msg->height == height + 1);
+    }
+    CHECK(deleted == true); // some heights must have been rotated out
+  };
+
+  {
+    base_wal wal_(tmp_path, "wal", rotation_file_num, enc_size);
+    CHECK(wal_.on_start() == true);
+    write_heights(wal_);
+    check_heights(wal_);
+    CHECK(wal_.on_stop() == true);
+  }
+  REQUIRE(fs::exists(index_path));
+
+  SECTION("reload persisted index") {
+    base_wal wal_(tmp_path, "wal", rotation_file_num, enc_size);
+    check_heights(wal_);
+  }
+
+  SECTION("rebuild missing index") {
+    fs::remove(index_path);
+    base_wal wal_(tmp_path, "wal", rotation_file_num, enc_size);
+    check_heights(wal_);
+    CHECK(fs::exists(index_path));
+  }
+
+  SECTION("rebuild corrupted index") {
+    {
+      fc::cfile file;
+      file.set_file_path(index_path);
+      file.open(fc::cfile::update_rw_mode);
+      file.seek(wal_frame_header_size);
+      char c = 0x7f;
+      file.write(&c, 1);
+      file.flush();
+    }
+    base_wal wal_(tmp_path, "wal", rotation_file_num, enc_size);
+    check_heights(wal_);
+  }
+}
+
+TEST_CASE("basic_wal: concurrent write_sync", "[noir][consensus]") {
+  static constexpr size_t enc_size = 1024 * 1024;
+  static constexpr size_t thread_num = 5;
+  static constexpr size_t msg_num = 100;
+  auto mode = GENERATE(wal_sync_mode::group_commit, wal_sync_mode::async_writer);
+  auto temp_dir = std::make_shared<fc::temp_directory>();
+  auto tmp_path = temp_dir->path().string();
+  auto wal_ = std::make_shared<base_wal>(tmp_path, "wal", 5, enc_size, mode);
+  CHECK(wal_->sync_mode() == mode);
+  CHECK(wal_->on_start() == true);
+
+  auto thread = std::make_unique<noir::named_thread_pool>("test_thread", thread_num);
+  std::future<size_t> write_wal[thread_num];
+  for (auto& res : write_wal) {
+    res = noir::async_thread_pool(thread->get_executor(), [&]() {
+      size_t count = 0;
+      for (auto i = 0; i < msg_num; ++i) {
+        if (wal_->write_sync({noir::consensus::end_height_message{1}})) {
+          ++count;
+        }
+      }
+      return count;
+    });
+  }
+  size_t sum = 0;
+  for (auto& res : write_wal) {
+    sum += res.get();
+  }
+  CHECK(sum == thread_num * msg_num);
+  if (mode == wal_sync_mode::async_writer) {
+    auto ret = wal_->write_async({noir::consensus::end_height_message{2}});
+    CHECK(ret.get() == true);
+  }
+  CHECK(wal_->on_stop() == true);
+
+  // every synced message must be readable: initial end_height_message{0} + all written messages
+  wal_decoder dec{(fs::path(tmp_path) / "wal").string()};
+  timed_wal_message msg{};
+  size_t count = 0;
+  while (dec.decode(msg) == wal_decoder::result::success) {
+    ++count;
+  }
+  CHECK(count == thread_num * msg_num + (mode == wal_sync_mode::async_writer ? 2 : 1));
+}
+
 } // namespace
@@ -20,8 +20,21 @@ static tx_hash get_tx_hash(const tx& tx) {
   if (tx.size() == 0) {
     return tx_hash{};
   }
-  crypto::Sha3_256 hash;
-  return tx_hash{hash(tx)}; // FIXME
+  return crypto::sha3_256(tx);
+}
+
+static std::vector<tx_hash> get_tx_hashes(std::span<const tx_ptr> txs) {
+  std::vector<std::span<const unsigned char>> in;
+  in.reserve(txs.size());
+  for (const auto& tx : txs)
+    in.emplace_back(tx->data(), tx->size());
+  std::vector<tx_hash> hashes(txs.size());
+  crypto::hash_many<crypto::Sha3_256>(in, hashes);
+  for (size_t i = 0; i < txs.size(); i++) {
+    if (txs[i]->size() == 0)
+      hashes[i] = tx_hash{};
+  }
+  return hashes;
 }
 
 struct wrapped_tx {
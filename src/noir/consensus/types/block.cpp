@@ -10,6 +10,7 @@
 #include <noir/consensus/types/evidence.h>
 #include <noir/consensus/types/vote.h>
 #include <fmt/core.h>
+#include <google/protobuf/arena.h>
 
 namespace noir::consensus {
 
@@ -76,7 +77,7 @@ std::shared_ptr<part_set> part_set::new_part_set_from_data(const Bytes& data, ui
   // Divide data into 4KB parts
   uint32_t total = (data.size() + part_size - 1) / part_size;
   std::vector<std::shared_ptr<part>> parts(total);
-  std::vector<Bytes> parts_bytes(total);
+  std::vector<merkle::node_hash> leaves(total);
   auto parts_bit_array = bit_array::new_bit_array(total);
   for (auto i = 0; i < total; i++) {
     auto first = data.begin() + (i * part_size);
@@ -85,12 +86,12 @@ std::shared_ptr<part_set> part_set::new_part_set_from_data(const Bytes& data, ui
     part_->index = i;
     std::copy(first, last, std::back_inserter(part_->bytes_.raw()));
     parts[i] = part_;
-    parts_bytes[i] = part_->bytes_;
+    merkle::leaf_hash_to(part_->bytes_, leaves[i]);
     parts_bit_array->set_index(i, true);
   }
 
   // Compute merkle proof
-  auto [root, proofs] = merkle::proofs_from_bytes_list(parts_bytes);
+  auto [root, proofs] = merkle::proofs_from_leaf_hashes(std::move(leaves));
   for (auto i = 0; i < total; i++) {
     parts[i]->proof_ = *(proofs[i]);
   }
@@ -105,7 +106,7 @@ std::shared_ptr<part_set> part_set::new_part_set_from_data(const Bytes& data, ui
   return ret;
 }
 
-bool part_set::add_part(std::shared_ptr<part> part_) {
+bool part_set::insert_part(std::shared_ptr<part> part_, bool check_proof) {
   std::scoped_lock g(mtx);
 
   if (part_->index >= total) {
@@ -120,9 +121,11 @@ bool part_set::add_part(std::shared_ptr<part> part_) {
   }
 
   // Check hash proof
-  if (auto err = part_->proof_.verify(get_hash(), part_->bytes_); err.has_value()) {
-    elog("error part set invalid proof");
-    return false;
+  if (check_proof) {
+    if (auto err = part_->proof_.verify(hash, part_->bytes_); err.has_value()) {
+      elog("error part set invalid proof");
+      return false;
+    }
   }
 
   // Add part
@@ -143,9 +146,10 @@ Bytes block_data::get_hash() {
   if (this == nullptr) ///< NOT a very nice way of coding; need to refactor later
     return merkle::hash_from_bytes_list({});
   if (hash.empty()) {
-    merkle::bytes_list items;
-    for (const auto& tx : txs)
-      items.push_back(crypto::Sha256()(tx));
+    std::vector<std::span<const unsigned char>> in(txs.begin(), txs.end());
+    std::vector<Bytes32> tx_hashes(txs.size());
+    crypto::hash_many<crypto::Sha256>(in, tx_hashes);
+    merkle::bytes_list items(tx_hashes.begin(), tx_hashes.end());
     hash = merkle::hash_from_bytes_list(items);
   }
   return hash;
@@ -155,6 +159,10 @@ Bytes block_header::get_hash() {
   if (validators_hash.empty())
     return {};
 
+  // a header is hashed many times while its height is decided, mostly unchanged
+  if (auto cache = std::atomic_load(&hash_cache); cache && cache->fields == hashed_fields())
+    return cache->hash;
+
   auto pb_v = consensus_version::to_proto(version);
   auto bz_v = codec::protobuf::encode(*pb_v);
 
@@ -176,7 +184,12 @@ Bytes block_header::get_hash() {
   items.push_back(cdc_encode(last_results_hash));
   items.push_back(cdc_encode(evidence_hash));
   items.push_back(cdc_encode(proposer_address));
-  return merkle::hash_from_bytes_list(items);
+  auto hash = merkle::hash_from_bytes_list(items);
+
+  std::atomic_store(&hash_cache,
+    std::shared_ptr<const block_header_hash>(
+      std::make_shared<block_header_hash>(block_header_hash{hashed_fields(), hash})));
+  return hash;
 }
 
 Bytes evidence_data::get_hash() {
@@ -210,11 +223,19 @@ Result<std::shared_ptr<evidence_data>> evidence_data::from_proto(const ::tenderm
 std::shared_ptr<block> block::new_block_from_part_set(const std::shared_ptr<part_set>& ps) {
   if (!ps->is_complete())
     return {};
-  Bytes bz;
-  bz.raw().reserve(ps->byte_size);
+  std::vector<std::span<const unsigned char>> parts;
+  parts.reserve(ps->parts.size());
   for (const auto& p : ps->parts)
-    std::copy(p->bytes_.begin(), p->bytes_.end(), std::back_inserter(bz.raw()));
-  return block::from_proto(codec::protobuf::decode<::tendermint::types::Block>(bz));
+    parts.emplace_back(p->bytes_.data(), p->bytes_.size());
+  return new_block_from_parts(std::move(parts));
+}
+
+std::shared_ptr<block> block::new_block_from_parts(std::vector<std::span<const unsigned char>> parts) {
+  // the message is only an intermediate form, so allocate all of its fields at once and free them together
+  google::protobuf::Arena arena;
+  auto pb = google::protobuf::Arena::CreateMessage<::tendermint::types::Block>(&arena);
+  codec::protobuf::decode(std::move(parts), *pb);
+  return block::from_proto(*pb);
 }
 
 std::shared_ptr<part_set> block::make_part_set(uint32_t part_size) {
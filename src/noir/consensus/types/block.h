@@ -20,6 +20,7 @@
 #include <fmt/core.h>
 
 #include <memory>
+#include <tuple>
 #include <utility>
 
 namespace noir::consensus {
@@ -228,7 +229,17 @@ struct part_set {
 
   static std::shared_ptr<part_set> new_part_set_from_data(const Bytes& data, uint32_t part_size);
 
-  bool add_part(std::shared_ptr<part> part_);
+  /// \brief adds a part after checking its merkle proof
+  /// \return true if the part is added
+  bool add_part(std::shared_ptr<part> part_) {
+    return insert_part(std::move(part_), true);
+  }
+
+  /// \brief adds a part whose merkle proof the caller has already checked against the hash of this part set
+  /// \return true if the part is added
+  bool add_verified_part(std::shared_ptr<part> part_) {
+    return insert_part(std::move(part_), false);
+  }
 
   bool is_complete() {
     return count == total;
@@ -255,6 +266,9 @@ struct part_set {
   }
 
   Bytes get_hash();
+
+private:
+  bool insert_part(std::shared_ptr<part> part_, bool check_proof);
 };
 
 struct block_data {
@@ -280,6 +294,8 @@ struct block_data {
   }
 };
 
+struct block_header_hash;
+
 struct block_header {
   consensus_version version;
   std::string chain_id;
@@ -303,6 +319,16 @@ struct block_header {
   Bytes evidence_hash;
   Bytes proposer_address; // todo - use address type?
 
+  // memoized hash with the fields it is computed from; NOTE: not to be serialized
+  std::shared_ptr<const block_header_hash> hash_cache{};
+
+  /// \brief fields the hash is computed from
+  auto hashed_fields() const {
+    return std::tie(version, chain_id, height, time, last_block_id, last_commit_hash, data_hash, validators_hash,
+      next_validators_hash, consensus_hash, app_hash, last_results_hash, evidence_hash, proposer_address);
+  }
+
+  /// \brief computes the merkle root of the header fields; the result is memoized until any of the fields changes
   Bytes get_hash();
 
   void populate(consensus::consensus_version& version_,
@@ -419,6 +445,15 @@ struct block_header {
   }
 };
 
+/// \brief memoized hash of a block_header
+struct block_header_hash {
+  using fields_type = std::tuple<consensus_version, std::string, int64_t, tstamp, p2p::block_id, Bytes, Bytes, Bytes,
+    Bytes, Bytes, Bytes, Bytes, Bytes, Bytes>;
+
+  fields_type fields;
+  Bytes hash;
+};
+
 struct evidence_list;
 struct evidence_data {
   std::shared_ptr<evidence_list> evs{};
@@ -478,6 +513,9 @@ struct block {
 
   static std::shared_ptr<block> new_block_from_part_set(const std::shared_ptr<part_set>& ps);
 
+  /// \brief decodes a block from the bytes of its parts in one pass, without concatenating them
+  static std::shared_ptr<block> new_block_from_parts(std::vector<std::span<const unsigned char>> parts);
+
   std::optional<std::string> validate_basic() {
     std::scoped_lock g(mtx);
 
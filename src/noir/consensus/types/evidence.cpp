@@ -4,6 +4,7 @@
 // SPDX-License-Identifier: AGPL-3.0-or-later
 //
 #include <noir/codec/datastream.h>
+#include <noir/common/check.h>
 #include <noir/common/varint.h>
 #include <noir/consensus/types/evidence.h>
 #include <noir/consensus/types/protobuf.h>
@@ -70,9 +71,9 @@ std::vector<std::shared_ptr<validator>> light_client_attack_evidence::get_byzant
       if (!commit_sig.for_block())
         continue;
       auto val = common_vals->get_by_address(commit_sig.validator_address);
-      if (!val.has_value())
+      if (!val)
         continue;
-      ret.emplace_back(std::make_shared<validator>(val.value()));
+      ret.emplace_back(std::make_shared<validator>(*val));
     }
     sort(ret.begin(), ret.end(), [](const std::shared_ptr<validator>& a, const std::shared_ptr<validator>& b) {
       return a->voting_power < b->voting_power;
@@ -87,7 +88,8 @@ std::vector<std::shared_ptr<validator>> light_client_attack_evidence::get_byzant
       if (!sig_B.for_block())
         continue;
       auto val = conflicting_block->val_set->get_by_address(sig_A.validator_address);
-      ret.emplace_back(std::make_shared<validator>(val.value()));
+      check(val, "unable to find validator in conflicting validator_set");
+      ret.emplace_back(std::make_shared<validator>(*val));
     }
   }
   return ret;
@@ -44,7 +44,7 @@ struct duplicate_vote_evidence : public evidence {
     if (!val_set)
       return Error::format("missing validator_set");
     auto val = val_set->get_by_address(vote1->validator_address);
-    if (!val.has_value())
+    if (!val)
       return Error::format("validator is not in validator_set");
     std::shared_ptr<vote> vote_a_, vote_b_;
     if (vote1->block_id_.key() < vote2->block_id_.key()) {
@@ -40,7 +40,7 @@ std::shared_ptr<node_key> node_key::load_node_key(const std::filesystem::path& f
 
 std::string node_key::node_id_from_pub_key(const Bytes& pub_key) {
   check(pub_key.size() == 32, "unable to get a node_id: invalid public key size");
-  auto h = crypto::Sha256()(pub_key);
+  auto h = crypto::sha256(pub_key);
   auto address = Bytes(h.begin(), h.begin() + 20);
   return to_hex(address);
 }
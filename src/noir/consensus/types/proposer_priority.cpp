@@ -0,0 +1,96 @@
+// This file is part of NOIR.
+//
+// Copyright (c) 2022 Haderech Pte. Ltd.
+// SPDX-License-Identifier: AGPL-3.0-or-later
+//
+#include <noir/consensus/types/proposer_priority.h>
+#include <noir/consensus/types/validator.h>
+#include <algorithm>
+#include <bit>
+
+namespace noir::consensus {
+
+namespace {
+  __int128 floor_div(__int128 a, __int128 b) {
+    auto q = a / b;
+    return (a % b != 0 && (a < 0) != (b < 0)) ? q - 1 : q;
+  }
+
+  __int128 ceil_div(__int128 a, __int128 b) {
+    return -floor_div(-a, b);
+  }
+
+  int64_t to_round(__int128 r) {
+    return r >= INT64_MAX ? INT64_MAX : static_cast<int64_t>(r);
+  }
+} // namespace
+
+proposer_priority_queue::proposer_priority_queue(std::vector<validator>& validators, int64_t total_voting_power)
+  : validators(validators), total_voting_power(total_voting_power) {
+  leaves = std::bit_ceil(std::max<size_t>(validators.size(), 1));
+  base.reserve(validators.size());
+  voting_power.reserve(validators.size());
+  for (const auto& val : validators) {
+    base.push_back(val.proposer_priority);
+    voting_power.push_back(val.voting_power);
+  }
+  winner.assign(2 * leaves, -1);
+  expires.assign(2 * leaves, never);
+  for (size_t i = 0; i < validators.size(); i++)
+    winner[leaves + i] = static_cast<int32_t>(i);
+  for (auto node = leaves - 1; node > 0; node--)
+    update(node);
+}
+
+// recomputes the winner of an internal node from its children and the round in which the winner changes
+void proposer_priority_queue::update(size_t node) {
+  auto a = winner[2 * node];
+  auto b = winner[2 * node + 1];
+  auto expires_at = std::min(expires[2 * node], expires[2 * node + 1]);
+  if (a < 0 || b < 0) {
+    winner[node] = a < 0 ? b : a;
+    expires[node] = expires_at;
+    return;
+  }
+
+  // the left (lower index) one wins on ties
+  if (priority(a) >= priority(b)) {
+    winner[node] = a;
+    // b overtakes a in the first round r where base_a + r * vp_a < base_b + r * vp_b
+    if (voting_power[b] > voting_power[a])
+      expires_at = std::min(expires_at, to_round(floor_div(base[a] - base[b], voting_power[b] - voting_power[a]) + 1));
+  } else {
+    winner[node] = b;
+    // a catches up with b in the first round r where base_a + r * vp_a >= base_b + r * vp_b
+    if (voting_power[a] > voting_power[b])
+      expires_at = std::min(expires_at, to_round(ceil_div(base[b] - base[a], voting_power[a] - voting_power[b])));
+  }
+  expires[node] = expires_at;
+}
+
+// re-evaluates nodes whose winner is no longer valid in the current round
+void proposer_priority_queue::advance(size_t node) {
+  if (node >= leaves || expires[node] > rounds)
+    return;
+  advance(2 * node);
+  advance(2 * node + 1);
+  update(node);
+}
+
+int32_t proposer_priority_queue::increment() {
+  rounds++;
+  advance(1);
+
+  auto proposer = winner[1];
+  base[proposer] -= total_voting_power;
+  for (auto node = (leaves + proposer) / 2; node > 0; node /= 2)
+    update(node);
+  return proposer;
+}
+
+void proposer_priority_queue::flush() {
+  for (size_t i = 0; i < validators.size(); i++)
+    validators[i].proposer_priority = static_cast<int64_t>(priority(i));
+}
+
+} // namespace noir::consensus
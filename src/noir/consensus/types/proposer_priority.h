@@ -0,0 +1,56 @@
+// This file is part of NOIR.
+//
+// Copyright (c) 2022 Haderech Pte. Ltd.
+// SPDX-License-Identifier: AGPL-3.0-or-later
+//
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace noir::consensus {
+
+struct validator;
+
+/// \brief selects proposers over consecutive rounds without touching every validator in each round
+///
+/// In each round every validator gains its voting power, the validator with the highest priority (the first one in
+/// vector order on ties) becomes the proposer, and its priority drops by the total voting power. Priorities are kept
+/// as `base + rounds * voting_power` so a round only updates the proposer, and the proposer is tracked by a kinetic
+/// tournament tree whose nodes remember the round in which their winner will be overtaken. Each round costs
+/// O(log^2 n) amortized instead of O(n), and the resulting priorities and proposers are identical to the linear loop.
+class proposer_priority_queue {
+public:
+  /// \brief builds the queue from current priorities
+  /// \param[in] validators validator list; must outlive the queue and must not be modified until flush()
+  /// \param[in] total_voting_power amount subtracted from each proposer's priority
+  proposer_priority_queue(std::vector<validator>& validators, int64_t total_voting_power);
+
+  /// \brief advances one round
+  /// \return index of the proposer of the round
+  int32_t increment();
+
+  /// \brief writes the current priorities back to validators
+  void flush();
+
+private:
+  static constexpr int64_t never = INT64_MAX;
+
+  __int128 priority(int32_t i) const {
+    return base[i] + static_cast<__int128>(rounds) * voting_power[i];
+  }
+
+  void update(size_t node);
+  void advance(size_t node);
+
+  std::vector<validator>& validators;
+  int64_t total_voting_power;
+  int64_t rounds{0};
+  size_t leaves{1};
+  std::vector<__int128> base;
+  std::vector<int64_t> voting_power;
+  std::vector<int32_t> winner; // -1 for padding leaves
+  std::vector<int64_t> expires; // earliest round in which any winner in the subtree changes
+};
+
+} // namespace noir::consensus
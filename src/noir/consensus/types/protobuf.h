@@ -29,7 +29,7 @@ struct tm2pb {
   static std::vector<::tendermint::abci::ValidatorUpdate> validator_updates(
     const std::shared_ptr<validator_set>& vals) {
     std::vector<::tendermint::abci::ValidatorUpdate> ret;
-    for (auto& val : vals->validators)
+    for (auto& val : vals->get_validators())
       ret.push_back(tm2pb::validator_update(std::make_shared<validator>(val)));
     return ret;
   }
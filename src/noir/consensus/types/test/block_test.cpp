@@ -31,6 +31,30 @@ TEST_CASE("block: make part_set", "[noir][consensus]") {
   CHECK(restored->data.get_hash() == org.data.get_hash());
   CHECK(restored->data.txs[0] == Bytes{"abcd"});
   CHECK(restored->data.txs[1] == Bytes{"1234"});
+
+  // decoded across parts without concatenating them
+  ps = org.make_part_set(3);
+  CHECK(ps->total > 2);
+  restored = block::new_block_from_part_set(ps);
+  CHECK(restored->data.get_hash() == org.data.get_hash());
+  CHECK(restored->data.txs[1] == Bytes{"1234"});
+}
+
+TEST_CASE("block: add parts to part_set", "[noir][consensus]") {
+  Bytes data(1000);
+  std::fill(data.raw().begin(), data.raw().end(), 'a');
+  auto full = part_set::new_part_set_from_data(data, 100);
+  auto ps = part_set::new_part_set_from_header(full->header());
+
+  auto tampered = std::make_shared<part>(*full->get_part(0));
+  tampered->bytes_.raw()[0] ^= 1;
+  CHECK(!ps->add_part(tampered));
+
+  for (auto i = 0; i < full->total; i++)
+    CHECK(i % 2 ? ps->add_verified_part(full->get_part(i)) : ps->add_part(full->get_part(i)));
+  CHECK(!ps->add_part(full->get_part(0)));
+  CHECK(ps->is_complete());
+  CHECK(ps->byte_size == data.size());
 }
 
 TEST_CASE("block: encode using datastream", "[noir][consensus]") {
@@ -219,4 +243,12 @@ TEST_CASE("block: verify header hash", "[noir][consensus]") {
     .proposer_address = {proposer_address_hash.begin(), proposer_address_hash.begin() + 20},
   };
   CHECK(h.get_hash() == Bytes("f740121f553b5418c3efbd343c2dbfe9e007bb67b0d020a0741374bab65242a4"));
+
+  // memoized hash follows changes of fields
+  CHECK(h.get_hash() == Bytes("f740121f553b5418c3efbd343c2dbfe9e007bb67b0d020a0741374bab65242a4"));
+  auto copy = h;
+  h.height = 4;
+  CHECK(h.get_hash() != copy.get_hash());
+  h.height = 3;
+  CHECK(h.get_hash() == copy.get_hash());
 }
@@ -0,0 +1,51 @@
+// This file is part of NOIR.
+//
+// Copyright (c) 2022 Haderech Pte. Ltd.
+// SPDX-License-Identifier: AGPL-3.0-or-later
+//
+#include <catch2/catch_all.hpp>
+#include <noir/consensus/types/validator.h>
+
+using namespace noir;
+using namespace noir::consensus;
+
+TEST_CASE("ValidatorSetBenchmarks", "[noir][consensus]") {
+  static constexpr auto num_vals = 10000;
+  static constexpr auto rounds = 100;
+
+  std::vector<validator> validators;
+  for (auto i = 0; i < num_vals; i++) {
+    Bytes address(20);
+    address[0] = i >> 8;
+    address[1] = i & 0xff;
+    validators.push_back(validator{address, {}, 1 + (i * 7919) % 1000, 0});
+  }
+  auto vals = validator_set::new_validator_set(validators);
+
+  BENCHMARK_ADVANCED("IncrementProposerPriorityLinear")(Catch::Benchmark::Chronometer meter) {
+    auto copy_ = vals->get_validators();
+    meter.measure([&]() {
+      for (auto r = 0; r < rounds; r++) {
+        for (auto& val : copy_)
+          val.proposer_priority += val.voting_power;
+        auto it = std::max_element(copy_.begin(), copy_.end(),
+          [](const validator& a, const validator& b) { return a.proposer_priority < b.proposer_priority; });
+        it->proposer_priority -= vals->total_voting_power;
+      }
+    });
+  };
+
+  BENCHMARK_ADVANCED("IncrementProposerPriorityQueue")(Catch::Benchmark::Chronometer meter) {
+    auto copy_ = vals->get_validators();
+    meter.measure([&]() {
+      proposer_priority_queue queue(copy_, vals->total_voting_power);
+      for (auto r = 0; r < rounds; r++)
+        queue.increment();
+      queue.flush();
+    });
+  };
+
+  BENCHMARK_ADVANCED("CopyIncrementProposerPriority")(Catch::Benchmark::Chronometer meter) {
+    meter.measure([&]() { return vals->copy_increment_proposer_priority(rounds); });
+  };
+}
@@ -12,7 +12,7 @@ using namespace noir::consensus;
 
 void print_validator_set(const std::shared_ptr<validator_set>& vals) {
   auto index = 0;
-  for (auto val : vals->validators)
+  for (auto val : vals->get_validators())
     std::cout << index++ << ":" << to_hex(val.address) << " " << val.voting_power << " " << val.proposer_priority
               << std::endl;
 }
@@ -25,17 +25,16 @@ TEST_CASE("validator_set: Basic", "[noir][consensus]") {
   }
 
   SECTION("non-positive times") {
-    validator val;
-    vals->validators.push_back(val);
+    vals->set_validators({validator{}});
     CHECK_THROWS_WITH(vals->increment_proposer_priority(0), "cannot call with non-positive times");
   }
 
   SECTION("get by") {
     validator val = {from_hex("0123456789")};
-    vals->validators.push_back(val);
-    CHECK(vals->get_by_index(-1) == std::nullopt);
-    CHECK(vals->get_by_index(3) == std::nullopt);
-    CHECK(vals->get_by_index(0).value().address == val.address);
+    vals->set_validators({val});
+    CHECK(vals->get_by_index(-1) == nullptr);
+    CHECK(vals->get_by_index(3) == nullptr);
+    CHECK(vals->get_by_index(0)->address == val.address);
   }
 }
 
@@ -158,3 +157,70 @@ TEST_CASE("validator_set: Apply update", "[noir][consensus]") {
     CHECK(vals->get_by_index(1)->voting_power == 6);
   }
 }
+
+TEST_CASE("validator_set: Address index", "[noir][consensus]") {
+  auto vals = validator_set::new_validator_set(
+    {validator{from_hex("0044"), {}, 44}, validator{from_hex("0066"), {}, 66}});
+  auto check_index = [](const std::shared_ptr<validator_set>& vals) {
+    for (auto i = 0; i < vals->size(); i++) {
+      auto& address = vals->get_by_index(i)->address;
+      CHECK(vals->has_address(address));
+      CHECK(vals->get_index_by_address(address) == i);
+      CHECK(vals->get_by_address(address) == vals->get_by_index(i));
+    }
+  };
+  check_index(vals);
+  CHECK(!vals->has_address(from_hex("0055")));
+  CHECK(vals->get_by_address(from_hex("0055")) == nullptr);
+
+  SECTION("update") {
+    CHECK(vals->update_with_change_set(
+      {validator{from_hex("0055"), {}, 55}, validator{from_hex("0066"), {}, 0}, validator{from_hex("0044"), {}, 4}},
+      true));
+    CHECK(vals->size() == 2);
+    CHECK(!vals->has_address(from_hex("0066")));
+    CHECK(vals->get_by_address(from_hex("0044"))->voting_power == 4);
+    check_index(vals);
+  }
+
+  SECTION("copy") {
+    auto copy_ = vals->copy_increment_proposer_priority(3);
+    check_index(copy_);
+    CHECK(copy_->get_by_address(from_hex("0044")) != vals->get_by_address(from_hex("0044")));
+  }
+
+  SECTION("replacement") {
+    auto removed = vals->get_by_index(0)->address;
+    vals->set_validators({validator{from_hex("0077"), {}, 77}, *vals->get_by_index(1)});
+    CHECK(!vals->has_address(removed));
+    CHECK(vals->get_index_by_address(removed) == -1);
+    check_index(vals);
+  }
+}
+
+TEST_CASE("validator_set: Proposer priority queue", "[noir][consensus]") {
+  auto [num_vals, max_power] = GENERATE(table<int, int64_t>({{1, 10}, {3, 3}, {17, 1000}, {100, 100000}}));
+  auto rounds = 500;
+
+  std::vector<validator> expected;
+  int64_t total_voting_power{0};
+  for (auto i = 0; i < num_vals; i++) {
+    auto voting_power = 1 + (i * 7919) % max_power;
+    expected.push_back(validator{{}, {}, voting_power, (i * 104729) % 2001 - 1000});
+    total_voting_power += voting_power;
+  }
+  auto actual = expected;
+
+  proposer_priority_queue queue(actual, total_voting_power);
+  for (auto r = 0; r < rounds; r++) {
+    for (auto& val : expected)
+      val.proposer_priority += val.voting_power;
+    auto it = std::max_element(expected.begin(), expected.end(),
+      [](const validator& a, const validator& b) { return a.proposer_priority < b.proposer_priority; });
+    it->proposer_priority -= total_voting_power;
+    REQUIRE(queue.increment() == it - expected.begin());
+  }
+  queue.flush();
+  for (auto i = 0; i < num_vals; i++)
+    CHECK(actual[i].proposer_priority == expected[i].proposer_priority);
+}
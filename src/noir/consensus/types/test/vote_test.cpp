@@ -6,6 +6,7 @@
 #include <catch2/catch_all.hpp>
 #include <noir/codec/protobuf.h>
 #include <noir/common/hex.h>
+#include <noir/consensus/common_test.h>
 #include <noir/consensus/types/canonical.h>
 #include <noir/consensus/types/priv_validator.h>
 #include <noir/consensus/types/vote.h>
@@ -76,3 +77,47 @@ TEST_CASE("vote: verify signature", "[noir][consensus]") {
   // Verify
   CHECK(val.get_pub_key().verify_signature(bz_sign_bytes, vote_.signature));
 }
+
+TEST_CASE("vote_set: two thirds majority", "[noir][consensus]") {
+  auto [val_set, priv_vals] = rand_validator_set(10, 1);
+  auto votes = vote_set::new_vote_set("test_chain_id", 1, 0, p2p::Prevote, val_set);
+
+  auto block_a = p2p::block_id{.hash = crypto::Sha256()(string_to_bytes("a")), .parts = {1, Bytes(32)}};
+  auto block_b = p2p::block_id{.hash = crypto::Sha256()(string_to_bytes("b")), .parts = {1, Bytes(32)}};
+  auto add = [&](int32_t index, const p2p::block_id& block_id_) {
+    auto vote_ = std::make_shared<vote>(vote{{.type = p2p::Prevote,
+      .height = 1,
+      .round = 0,
+      .block_id_ = block_id_,
+      .validator_address = priv_vals[index]->get_pub_key().address(),
+      .validator_index = index}});
+    CHECK(!priv_vals[index]->sign_vote("test_chain_id", *vote_).has_value());
+    return votes->add_vote(vote_);
+  };
+
+  for (auto i = 0; i < 6; i++)
+    CHECK(add(i, block_a).first);
+  CHECK(!votes->has_two_thirds_any());
+  CHECK(!votes->two_thirds_majority().has_value());
+
+  // 2/3+ of votes, but not for a single block
+  CHECK(add(6, p2p::block_id{}).first);
+  CHECK(votes->has_two_thirds_any());
+  CHECK(!votes->has_two_thirds_majority());
+
+  CHECK(add(7, block_a).first);
+  CHECK(votes->two_thirds_majority() == block_a);
+  CHECK(votes->bit_array_by_block_id(block_a)->get_index(7));
+
+  // a conflicting vote is rejected until a peer claims a majority for its block
+  CHECK(!add(0, block_b).first);
+  CHECK(!votes->set_peer_maj23("peer", block_b).has_value());
+  CHECK(add(0, block_b).first);
+  CHECK(votes->bit_array_by_block_id(block_b)->get_index(0));
+  CHECK(votes->votes[0]->block_id_ == block_a);
+
+  CHECK(!votes->has_all());
+  CHECK(add(8, block_b).first);
+  CHECK(add(9, block_a).first);
+  CHECK(votes->has_all());
+}
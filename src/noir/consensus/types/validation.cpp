@@ -36,11 +36,11 @@ std::optional<std::string> verify_commit_single(const std::string& chain_id_,
   bool count_all_signatures,
   bool lookup_by_index) {
 
-  validator val{};
-  int32_t val_idx{0};
+  const validator* val{};
   int64_t tallied_voting_power{0};
   std::map<int32_t, int> seen_vals;
-  Bytes vote_sign_bytes;
+  batch_verifier bv;
+  std::vector<int> sig_idxs;
 
   for (auto i = 0; i < commit_->signatures.size(); i++) {
     auto& commit_sig_ = commit_->signatures[i];
@@ -48,13 +48,12 @@ std::optional<std::string> verify_commit_single(const std::string& chain_id_,
       continue;
 
     if (lookup_by_index) {
-      val = vals->validators[i];
+      val = vals->get_by_index(i);
     } else {
-      auto val_opt = vals->get_by_address(commit_sig_.validator_address);
-      if (!val_opt.has_value())
-        continue;
-      val = val_opt.value();
       auto val_index = vals->get_index_by_address(commit_sig_.validator_address);
+      if (val_index < 0)
+        continue;
+      val = vals->get_by_index(val_index);
 
       // Check if same validator committed twice
       if (auto it = seen_vals.find(val_index); it != seen_vals.end()) {
@@ -65,13 +64,20 @@ std::optional<std::string> verify_commit_single(const std::string& chain_id_,
     }
 
     auto vote_ = commit_->get_vote(i);
-    vote_sign_bytes = vote::vote_sign_bytes(chain_id_, *vote::to_proto(*vote_));
-    if (!val.pub_key_.verify_signature(vote_sign_bytes, commit_sig_.signature))
-      return fmt::format("verification failed: wrong signature - index={}", i);
+    bv.add(val->pub_key_, vote::vote_sign_bytes(chain_id_, *vote::to_proto(*vote_)), commit_sig_.signature);
+    sig_idxs.push_back(i);
 
-    tallied_voting_power += val.voting_power;
+    // signatures are verified all at once below; stop collecting once enough voting power is gathered
+    tallied_voting_power += val->voting_power;
     if (!count_all_signatures && tallied_voting_power > voting_power_needed)
-      return {};
+      break;
+  }
+
+  if (auto [ok, valid_sigs] = bv.verify(); !ok) {
+    for (auto i = 0; i < valid_sigs.size(); i++) {
+      if (!valid_sigs[i])
+        return fmt::format("verification failed: wrong signature - index={}", sig_idxs[i]);
+    }
   }
 
   if (tallied_voting_power <= voting_power_needed)
@@ -93,9 +99,7 @@ std::optional<std::string> verify_commit_light(const std::string& chain_id_,
   // Calculate required voting power
   auto voting_power_needed = vals->total_voting_power * 2 / 3;
 
-  // Batch verification // TODO: is this required?
-
-  // Single verification
+  // Signatures are batch verified inside
   return verify_commit_single(chain_id_, vals, commit_, voting_power_needed, false, true);
 }
 
@@ -4,11 +4,16 @@
 // SPDX-License-Identifier: AGPL-3.0-or-later
 //
 #pragma once
+#include <noir/codec/bcs.h>
+#include <noir/common/check.h>
 #include <noir/consensus/crypto.h>
+#include <noir/consensus/types/proposer_priority.h>
 #include <noir/core/result.h>
 #include <noir/p2p/protocol.h>
 #include <noir/p2p/types.h>
 #include <tendermint/types/types.pb.h>
+#include <string_view>
+#include <unordered_map>
 
 namespace noir::consensus {
 
@@ -77,7 +82,6 @@ struct validator {
 };
 
 struct validator_set : public std::enable_shared_from_this<validator_set> {
-  std::vector<validator> validators;
   std::optional<validator> proposer;
   int64_t total_voting_power = 0;
   // private:
@@ -104,34 +108,41 @@ public:
 
   Bytes get_hash();
 
-  bool has_address(const Bytes& address) {
-    for (const auto& val : validators) {
-      if (val.address == address)
-        return true;
-    }
-    return false;
+  /// \brief returns validators of the set, sorted by voting power and address
+  const std::vector<validator>& get_validators() const {
+    return validators;
   }
 
-  std::optional<validator> get_by_address(const Bytes& address) {
-    for (auto val : validators) {
-      if (val.address == address)
-        return val;
-    }
-    return {};
+  /// \brief replaces validators of the set as they are, keeping their order and proposer priorities
+  /// Meant for decoding a stored set; use update_with_change_set() to apply validator changes.
+  void set_validators(std::vector<validator> vals) {
+    validators = std::move(vals);
+    reindex();
   }
 
-  int32_t get_index_by_address(const Bytes& address) {
-    for (auto idx = 0; idx < validators.size(); idx++) {
-      if (validators[idx].address == address)
-        return idx;
-    }
-    return -1;
+  bool has_address(const Bytes& address) const {
+    return get_index_by_address(address) >= 0;
+  }
+
+  /// \brief returns the validator with the given address, or nullptr if it is not in the set
+  const validator* get_by_address(const Bytes& address) const {
+    auto idx = get_index_by_address(address);
+    return idx < 0 ? nullptr : &validators[idx];
   }
 
-  std::optional<validator> get_by_index(int32_t index) {
+  int32_t get_index_by_address(const Bytes& address) const {
+    auto it = address_index.find(address);
+    if (it == address_index.end())
+      return -1;
+    check(validators[it->second].address == address, "validator address index out of sync");
+    return it->second;
+  }
+
+  /// \brief returns the validator at the given index, or nullptr if it is out of range
+  const validator* get_by_index(int32_t index) const {
     if (index < 0 || index >= validators.size())
-      return {};
-    return validators.at(index);
+      return nullptr;
+    return &validators[index];
   }
 
   int64_t get_total_voting_power() {
@@ -175,41 +186,34 @@ public:
    */
   void apply_updates(std::vector<validator>& updates) {
     std::vector<validator> existing(validators);
-    sort(existing.begin(), existing.end(), [](validator a, validator b) { return a.address < b.address; });
+    sort(existing.begin(), existing.end(),
+      [](const validator& a, const validator& b) { return a.address < b.address; });
 
     std::vector<validator> merged;
-    merged.resize(existing.size() + updates.size());
-    auto i = 0;
-    while (!existing.empty() && !updates.empty()) {
-      if (existing[0].address < updates[0].address) {
-        merged[i] = existing[0];
-        existing.erase(existing.begin());
+    merged.reserve(existing.size() + updates.size());
+    auto e = existing.begin();
+    auto u = updates.begin();
+    while (e != existing.end() && u != updates.end()) {
+      if (e->address < u->address) {
+        merged.push_back(std::move(*e++));
       } else {
         // apply add or update
-        merged[i] = updates[0];
-        if (existing[0].address == updates[0].address) {
+        if (e->address == u->address) {
           // validator is present in both, advance existing
-          existing.erase(existing.begin());
+          e++;
         }
-        updates.erase(updates.begin());
+        merged.push_back(*u++);
       }
-      i++;
     }
 
     // add the elements which are left
-    for (auto& j : existing) {
-      merged[i] = j;
-      i++;
-    }
+    std::move(e, existing.end(), std::back_inserter(merged));
     // Or, add updates which are left
-    for (auto& update : updates) {
-      merged[i] = update;
-      i++;
-    }
+    std::copy(u, updates.end(), std::back_inserter(merged));
+    updates.clear();
 
-    validators.clear();
-    for (auto j = 0; j < i; j++)
-      validators.push_back(merged[j]);
+    validators = std::move(merged);
+    reindex();
   }
 
   /** \brief Removes the validators specified in 'deletes' from validator set 'vals'.
@@ -217,32 +221,22 @@ public:
    * Expects vals to be sorted by address (done by applyUpdates).
    */
   void apply_removals(std::vector<validator>& deletes) {
-    std::vector<validator> existing(validators);
-
     std::vector<validator> merged;
-    merged.resize(existing.size() - deletes.size());
-    auto i = 0;
+    merged.reserve(validators.size() - deletes.size());
+    auto d = deletes.begin();
     // Loop over deletes until we removed all of them.
-    while (!deletes.empty()) {
-      if (existing[0].address == deletes[0].address) {
-        deletes.erase(deletes.begin());
+    for (auto& val : validators) {
+      if (d != deletes.end() && val.address == d->address) {
+        d++;
       } else {
         // Leave it in the resulting slice.
-        merged[i] = existing[0];
-        i++;
+        merged.push_back(std::move(val));
       }
-      existing.erase(existing.begin());
-    }
-
-    // add the elements which are left
-    for (auto& j : existing) {
-      merged[i] = j;
-      i++;
     }
+    deletes.clear();
 
-    validators.clear();
-    for (auto j = 0; j < i; j++)
-      validators.push_back(merged[j]);
+    validators = std::move(merged);
+    reindex();
   }
 
   /** \brief attempts to update the validator set with 'changes'.
@@ -264,10 +258,11 @@ public:
 
     // Check for duplicates within changes, split in 'updates' and 'deletes' lists (sorted).
     std::vector<validator> changesCopy(changes);
-    sort(changesCopy.begin(), changesCopy.end(), [](validator a, validator b) { return a.address < b.address; });
+    sort(changesCopy.begin(), changesCopy.end(),
+      [](const validator& a, const validator& b) { return a.address < b.address; });
     std::vector<validator> updates, deletes;
     Bytes prevAddr;
-    for (auto val_update : changesCopy) {
+    for (const auto& val_update : changesCopy) {
       if (val_update.address == prevAddr)
         return Error::format("duplicate entry {} in changes", to_hex(val_update.address));
       if (val_update.voting_power < 0) {
@@ -301,7 +296,7 @@ public:
     for (auto& val_update : deletes) {
       auto address = val_update.address;
       auto val = get_by_address(address);
-      if (!val.has_value())
+      if (!val)
         return Error::format("failed to find validator {} to remove", to_hex(address));
       removed_voting_power += val->voting_power;
     }
@@ -311,18 +306,18 @@ public:
 
     // Verify that applying the 'updates' against 'vals' will not result in error.
     // Get the updated total voting power before removal. Note that this is < 2 * MaxTotalVotingPower
-    auto delta = [](validator& update, const std::shared_ptr<validator_set>& vals) {
-      auto val = vals->get_by_address(update.address);
-      if (val.has_value())
+    auto delta = [this](const validator& update) {
+      auto val = get_by_address(update.address);
+      if (val)
         return update.voting_power - val->voting_power;
       return update.voting_power;
     };
     std::vector<validator> updatesCopy(updates);
     sort(updatesCopy.begin(), updatesCopy.end(),
-      [delta, this](validator a, validator b) { return delta(a, shared_from_this()) < delta(b, shared_from_this()); });
+      [&delta](const validator& a, const validator& b) { return delta(a) < delta(b); });
     auto tvp_after_removals = total_voting_power - removed_voting_power;
     for (auto& val_update : updatesCopy) {
-      tvp_after_removals += delta(val_update, shared_from_this());
+      tvp_after_removals += delta(val_update);
       if (tvp_after_removals > max_total_voting_power)
         return Error::format("total voting power of resulting valset exceeds max");
     }
@@ -341,11 +336,12 @@ public:
     rescale_priorities(priority_window_size_factor * get_total_voting_power());
     shift_by_avg_proposer_priority();
 
-    sort(validators.begin(), validators.end(), [](validator a, validator b) {
+    sort(validators.begin(), validators.end(), [](const validator& a, const validator& b) {
       if (a.voting_power == b.voting_power)
         return a.address < b.address;
       return a.voting_power > b.voting_power;
     });
+    reindex();
     return success();
   }
 
@@ -365,7 +361,7 @@ public:
     for (auto val_update : updates) {
       auto address = val_update.address;
       auto val = get_by_address(address);
-      if (!val.has_value()) {
+      if (!val) {
         // add val
         // Set ProposerPriority to -C*totalVotingPower (with C ~= 1.125) to make sure validators can't
         // un-bond and then re-bond to reset their (potentially previously negative) ProposerPriority to zero.
@@ -400,7 +396,7 @@ public:
     rescale_priorities(diff_max);
     shift_by_avg_proposer_priority();
 
-    for (auto i = 0; i < times; i++) {
+    if (times == 1) {
       for (auto& val : validators) {
         val.proposer_priority += val.voting_power; // todo - check safe add
       }
@@ -409,7 +405,16 @@ public:
         [](const validator& a, const validator& b) { return a.proposer_priority < b.proposer_priority; });
       it->proposer_priority -= total_voting_power;
       proposer = *it;
+      return;
     }
+
+    // Skipping many rounds (or heights) at once; avoid a full pass over validators for each round
+    proposer_priority_queue queue(validators, total_voting_power);
+    int32_t proposer_index{};
+    for (auto i = 0; i < times; i++)
+      proposer_index = queue.increment();
+    queue.flush();
+    proposer = validators[proposer_index];
   }
 
   /** \brief rescales the priorities such that the distance between the
@@ -487,6 +492,7 @@ public:
       return Error::format("from_proto failed: {}", ok.error().message());
     else
       ret->proposer = *ok.value();
+    ret->reindex();
     ret->get_total_voting_power();
     if (auto ok = ret->validate_basic(); !ok)
       return ok.error();
@@ -498,9 +504,46 @@ public:
     int64_t height,
     const std::shared_ptr<struct commit>& commit_);
   Result<void> verify_commit_light_trusting(const std::string& chain_id, const std::shared_ptr<struct commit>& commit_);
+
+private:
+  struct address_hash {
+    size_t operator()(const Bytes& address) const {
+      return std::hash<std::string_view>()({reinterpret_cast<const char*>(address.data()), address.size()});
+    }
+  };
+
+  // NOTE: private so that every change goes through a method which keeps address_index up to date
+  std::vector<validator> validators;
+  /// \brief position of each validator in validators, keyed by address
+  std::unordered_map<Bytes, int32_t, address_hash> address_index;
+
+  void reindex() {
+    address_index.clear();
+    address_index.reserve(validators.size());
+    for (auto idx = 0; idx < validators.size(); idx++)
+      address_index[validators[idx].address] = idx;
+  }
 };
 
+// validators are private, so validator_set is encoded by hand in the layout its reflection used to produce
+template<typename Stream>
+codec::bcs::datastream<Stream>& operator<<(codec::bcs::datastream<Stream>& ds, const validator_set& v) {
+  ds << v.get_validators();
+  ds << v.proposer;
+  ds << v.total_voting_power;
+  return ds;
+}
+
+template<typename Stream>
+codec::bcs::datastream<Stream>& operator>>(codec::bcs::datastream<Stream>& ds, validator_set& v) {
+  std::vector<validator> validators;
+  ds >> validators;
+  ds >> v.proposer;
+  ds >> v.total_voting_power;
+  v.set_validators(std::move(validators));
+  return ds;
+}
+
 } // namespace noir::consensus
 
 NOIR_REFLECT(noir::consensus::validator, address, pub_key_, voting_power, proposer_priority);
-NOIR_REFLECT(noir::consensus::validator_set, validators, proposer, total_voting_power);
@@ -48,12 +48,13 @@ std::shared_ptr<vote_set> vote_set::new_vote_set(const std::string& chain_id_,
   ret->height = height_;
   ret->round = round_;
   ret->signed_msg_type_ = signed_msg_type;
-  auto new_val_set = validator_set::new_validator_set({});
-  new_val_set = val_set_;
-  ret->val_set = new_val_set;
+  ret->val_set = val_set_;
   ret->votes_bit_array = bit_array::new_bit_array(val_set_->size());
   ret->votes.resize(val_set_->size());
+  ret->vote_blocks.assign(val_set_->size(), -1);
   ret->sum = 0;
+  ret->total_voting_power = val_set_->get_total_voting_power();
+  ret->quorum = ret->total_voting_power * 2 / 3 + 1;
   return ret;
 }
 
@@ -62,6 +63,78 @@ std::shared_ptr<bit_array> vote_set::get_bit_array() {
   return votes_bit_array->copy();
 }
 
+size_t vote_set::hash_block_id(const p2p::block_id& block_id_) {
+  auto hash = hash_value(block_id_.hash);
+  boost::hash_combine(hash, hash_value(block_id_.parts.hash));
+  boost::hash_combine(hash, block_id_.parts.total);
+  return hash;
+}
+
+int32_t vote_set::find_block_votes(const p2p::block_id& block_id_, size_t hash) const {
+  if (block_table.empty())
+    return -1;
+  auto mask = block_table.size() - 1;
+  for (auto i = hash & mask;; i = (i + 1) & mask) {
+    auto index = block_table[i];
+    if (index < 0)
+      return -1;
+    auto& bv = votes_by_block[index];
+    if (bv.hash == hash && bv.block_id_ == block_id_)
+      return index;
+  }
+}
+
+int32_t vote_set::add_block_votes(const p2p::block_id& block_id_, size_t hash, bool peer_maj23) {
+  auto index = static_cast<int32_t>(votes_by_block.size());
+  votes_by_block.push_back(block_votes{block_id_, hash, peer_maj23, bit_array::new_bit_array(val_set->size())});
+
+  // keep the load factor at or below 1/2
+  if (block_table.size() < 2 * votes_by_block.size()) {
+    block_table.assign(std::max<size_t>(8, 2 * block_table.size()), -1);
+    for (auto& bv : votes_by_block) {
+      auto mask = block_table.size() - 1;
+      auto i = bv.hash & mask;
+      while (block_table[i] >= 0)
+        i = (i + 1) & mask;
+      block_table[i] = static_cast<int32_t>(&bv - votes_by_block.data());
+    }
+  } else {
+    auto mask = block_table.size() - 1;
+    auto i = hash & mask;
+    while (block_table[i] >= 0)
+      i = (i + 1) & mask;
+    block_table[i] = index;
+  }
+  return index;
+}
+
+std::shared_ptr<vote> vote_set::get_vote(int32_t val_index, int32_t block_index) const {
+  if (block_index < 0)
+    return {};
+  if (vote_blocks[val_index] == block_index)
+    return votes[val_index];
+  auto& others = votes_by_block[block_index].votes;
+  if (!others.empty())
+    return others[val_index];
+  return {};
+}
+
+// places vote_ in votes, moving the vote it replaces to the block_votes it belongs to
+void vote_set::set_vote(int32_t val_index, int32_t block_index, std::shared_ptr<vote> vote_) {
+  if (auto prev_index = vote_blocks[val_index]; prev_index >= 0) {
+    auto& others = votes_by_block[prev_index].votes;
+    if (others.empty())
+      others.resize(votes.size());
+    others[val_index] = std::move(votes[val_index]);
+  }
+  auto& others = votes_by_block[block_index].votes;
+  if (!others.empty())
+    others[val_index] = nullptr;
+  votes[val_index] = std::move(vote_);
+  vote_blocks[val_index] = block_index;
+  votes_bit_array->set_index(val_index, true);
+}
+
 std::pair<bool, Error> vote_set::add_vote(const std::shared_ptr<vote>& vote_) {
   if (!vote_)
     check(false, "add_vote() on empty vote_set");
@@ -69,7 +142,6 @@ std::pair<bool, Error> vote_set::add_vote(const std::shared_ptr<vote>& vote_) {
 
   auto val_index = vote_->validator_index;
   auto val_addr = vote_->validator_address;
-  auto block_key = vote_->block_id_.key();
 
   // Ensure that validator index is set
   if (val_index < 0)
@@ -86,16 +158,18 @@ std::pair<bool, Error> vote_set::add_vote(const std::shared_ptr<vote>& vote_) {
 
   // Ensure that signer is a validator
   auto val = val_set->get_by_index(val_index);
-  if (!val)
+  if (!val || val_index >= votes.size())
     return {
-      false, Error::format("cannot find validator {} in val_set of size {}", val_index, val_set->validators.size())};
+      false, Error::format("cannot find validator {} in val_set of size {}", val_index, val_set->size())};
 
   // Ensure that signer has the right address
   if (val_addr != val->address)
     return {false, Error::format("signer has wrong address")};
 
   // Check if the same vote exists
-  if (auto existing = get_vote(val_index, block_key); existing) {
+  auto hash = hash_block_id(vote_->block_id_);
+  auto block_index = find_block_votes(vote_->block_id_, hash);
+  if (auto existing = get_vote(val_index, block_index); existing) {
     if (existing->signature == vote_->signature) {
       // duplicate
       return {false, Error{}};
@@ -104,42 +178,18 @@ std::pair<bool, Error> vote_set::add_vote(const std::shared_ptr<vote>& vote_) {
     return {false, ErrVoteNonDeterministicSignature};
   }
 
-  // Check signature
+  // Check signature; votes pre-verified by consensus_reactor are found in the signature cache
   if (val->pub_key_.address() != val_addr)
     return {false, Error::format("invalid validator address")};
-  auto vote_sign_bytes_ = vote::vote_sign_bytes(chain_id, *vote::to_proto(*vote_));
-  if (!val->pub_key_.verify_signature(vote_sign_bytes_, vote_->signature))
+  if (!vote_->verify(chain_id, val->pub_key_))
     return {false, Error::format("invalid signature")};
 
   // Add vote and get conflicting vote if any
   auto voting_power = val->voting_power;
-  std::shared_ptr<vote> conflicting{};
-
-  // Already exists in vote_set.votes?
-  if (votes.size() > 0 && votes.size() >= val_index && votes[val_index]) {
-    auto& existing = votes[val_index];
-    if (existing->block_id_ == vote_->block_id_) {
-      check(false, "add_vote() does not expect duplicate votes");
-    } else {
-      conflicting = existing;
-    }
-    // Replace vote if block_key matches vote_set.maj23
-    if (maj23.has_value() && maj23.value().key() == block_key) {
-      votes[val_index] = vote_;
-      votes_bit_array->set_index(val_index, true);
-    }
-    // Otherwise, don't add to vote_set.votes
-  } else {
-    // Add to vote_set.votes and increase sum
-    votes[val_index] = vote_;
-    votes_bit_array->set_index(val_index, true);
-    sum += voting_power;
-  }
+  std::shared_ptr<vote> conflicting = votes[val_index];
 
-  std::shared_ptr<block_votes> new_votes_by_block;
-  if (votes_by_block.contains(block_key)) {
-    new_votes_by_block = votes_by_block[block_key];
-    if (conflicting && votes_by_block[block_key]->peer_maj23) {
+  if (block_index >= 0) {
+    if (conflicting && !votes_by_block[block_index].peer_maj23) {
       // There's a conflict and no peer claims that this block is special.
       return {false, ErrVoteConflictingVotesWithData{conflicting, vote_}};
     }
@@ -151,26 +201,45 @@ std::pair<bool, Error> vote_set::add_vote(const std::shared_ptr<vote>& vote_) {
       return {false, ErrVoteConflictingVotesWithData{conflicting, vote_}};
     }
     // Start tracking this blockKey
-    new_votes_by_block = block_votes::new_block_votes(false, val_set->size());
-    votes_by_block[block_key] = new_votes_by_block;
-    // We'll add the vote in a bit.
+    block_index = add_block_votes(vote_->block_id_, hash, false);
+  }
+
+  if (!conflicting) {
+    // Add to vote_set.votes and increase sum
+    set_vote(val_index, block_index, vote_);
+    sum += voting_power;
+  } else if (block_index == maj23_index) {
+    // Replace vote if it is for vote_set.maj23
+    set_vote(val_index, block_index, vote_);
+  } else {
+    // Otherwise, don't add to vote_set.votes
+    auto& others = votes_by_block[block_index].votes;
+    if (others.empty())
+      others.resize(votes.size());
+    others[val_index] = vote_;
   }
 
   // Before adding to votesByBlock, see if we'll exceed quorum
-  auto orig_sum = new_votes_by_block->sum;
-  auto quorum = val_set->get_total_voting_power() * 2 / 3 + 1;
+  auto& bv = votes_by_block[block_index];
+  auto orig_sum = bv.sum;
 
   // Add vote to votesByBlock
-  new_votes_by_block->add_verified_vote(vote_, voting_power);
+  bv.bit_array_->set_index(val_index, true);
+  bv.sum += voting_power;
 
   // If we just crossed the quorum threshold and have 2/3 majority...
-  if (orig_sum < quorum && quorum <= new_votes_by_block->sum) {
+  if (orig_sum < quorum && quorum <= bv.sum) {
     // Only consider the first quorum reached
     if (!maj23.has_value()) {
-      auto maj23_block_id = vote_->block_id_;
-      maj23 = maj23_block_id;
+      maj23 = bv.block_id_;
+      maj23_index = block_index;
       // And also copy votes over to voteSet.votes
-      votes = new_votes_by_block->votes;
+      if (!bv.votes.empty()) {
+        for (auto i = 0; i < bv.votes.size(); i++) {
+          if (bv.votes[i])
+            set_vote(i, block_index, bv.votes[i]);
+        }
+      }
     }
   }
 
@@ -71,39 +71,25 @@ struct vote : p2p::vote_message {
   }
 
   static Bytes vote_sign_bytes(const std::string& chain_id, const ::tendermint::types::Vote& v);
+
+  /// \brief checks the signature of the vote
+  /// \param[in] chain_id chain id the vote is signed for
+  /// \param[in] key public key of the validator who signed the vote
+  /// \return true if the signature is valid
+  bool verify(const std::string& chain_id, const pub_key& key) const {
+    return key.verify_signature(vote_sign_bytes(chain_id, *to_proto(*this)), signature);
+  }
 };
 
+/// \brief votes of a vote_set for one block id
 struct block_votes {
+  p2p::block_id block_id_;
+  size_t hash{};
   bool peer_maj23{};
   std::shared_ptr<bit_array> bit_array_;
-  std::vector<std::shared_ptr<vote>> votes;
   int64_t sum{};
-
-  static std::shared_ptr<block_votes> new_block_votes(bool peer_maj23_, int num_validators) {
-    auto ret = std::make_shared<block_votes>();
-    ret->peer_maj23 = peer_maj23_;
-    ret->bit_array_ = bit_array::new_bit_array(num_validators);
-    ret->votes.resize(num_validators);
-    // std::fill(ret->votes.begin(), ret->votes.end(), nullptr);
-    return ret;
-  }
-
-  void add_verified_vote(const std::shared_ptr<vote>& vote_, int64_t voting_power) {
-    auto val_index = vote_->validator_index;
-    if (votes.size() > val_index) {
-      if (!votes[val_index]) {
-        bit_array_->set_index(val_index, true);
-        votes[val_index] = vote_;
-        sum += voting_power;
-      }
-    }
-  }
-
-  std::shared_ptr<vote> get_by_index(int32_t index) {
-    if (!votes.empty() && votes.size() > index)
-      return votes[index];
-    return {};
-  }
+  /// votes for this block that are not in vote_set::votes; allocated when the first of them is added
+  std::vector<std::shared_ptr<vote>> votes;
 };
 
 /**
@@ -138,6 +124,12 @@ struct block_votes {
  * told us to track that block, each peer only gets to tell us 1 such block, and,
  * there's only a limited number of peers.
  *
+ * In noir, `.votesByBlock` is a vector of block_votes indexed through a small
+ * open-addressed table of block ids, and `vote_blocks` records the block_votes
+ * each canonical vote belongs to. A block_votes only holds the votes that are
+ * not canonical, so every vote is stored once and the running sums make
+ * majority queries O(1).
+ *
  * NOTE: Assumes that the sum total of voting power does not exceed MaxUInt64.
  */
 struct vote_set {
@@ -150,9 +142,14 @@ struct vote_set {
   std::mutex mtx;
   std::shared_ptr<bit_array> votes_bit_array{};
   std::vector<std::shared_ptr<vote>> votes;
+  std::vector<int32_t> vote_blocks; ///< index into votes_by_block of each vote in votes; -1 if absent
   int64_t sum;
+  int64_t total_voting_power{};
+  int64_t quorum{};
   std::optional<p2p::block_id> maj23;
-  std::map<std::string, std::shared_ptr<block_votes>> votes_by_block;
+  int32_t maj23_index{-1};
+  std::vector<block_votes> votes_by_block;
+  std::vector<int32_t> block_table; ///< open-addressed table of indices into votes_by_block; -1 if empty
   std::map<P2PID, p2p::block_id> peer_maj23s;
 
   static std::shared_ptr<vote_set> new_vote_set(const std::string& chain_id_,
@@ -169,33 +166,20 @@ struct vote_set {
 
   std::pair<bool, Error> add_vote(const std::shared_ptr<vote>& vote_);
 
-  std::shared_ptr<vote> get_vote(int32_t val_index, const std::string& block_key) {
-    if (votes.size() > 0 && votes.size() > val_index && votes[val_index]) {
-      auto& existing = votes[val_index];
-      if (existing->block_id_.key() == block_key)
-        return existing;
-    }
-    if (votes_by_block.contains(block_key)) {
-      auto existing = votes_by_block[block_key]->get_by_index(val_index);
-      if (!existing)
-        return existing;
-    }
-    return {};
+  std::shared_ptr<vote> get_vote(int32_t val_index, const p2p::block_id& block_id_) {
+    return get_vote(val_index, find_block_votes(block_id_, hash_block_id(block_id_)));
   }
 
   std::shared_ptr<bit_array> bit_array_by_block_id(p2p::block_id block_id_) {
     std::scoped_lock g(mtx);
-    auto it = votes_by_block.find(block_id_.key());
-    if (it != votes_by_block.end())
-      return it->second->bit_array_->copy();
+    if (auto index = find_block_votes(block_id_, hash_block_id(block_id_)); index >= 0)
+      return votes_by_block[index].bit_array_->copy();
     return {};
   }
 
   std::optional<std::string> set_peer_maj23(std::string peer_id, p2p::block_id block_id_) {
     std::scoped_lock g(mtx);
 
-    auto block_key = block_id_.key();
-
     // Make sure peer has not sent us something yet
     if (auto it = peer_maj23s.find(peer_id); it != peer_maj23s.end()) {
       if (it->second == block_id_)
@@ -205,14 +189,11 @@ struct vote_set {
     peer_maj23s[peer_id] = block_id_;
 
     // Create votes_by_block
-    auto it = votes_by_block.find(block_key);
-    if (it != votes_by_block.end()) {
-      if (it->second->peer_maj23)
-        return {}; // nothing to do
-      it->second->peer_maj23 = true;
+    auto hash = hash_block_id(block_id_);
+    if (auto index = find_block_votes(block_id_, hash); index >= 0) {
+      votes_by_block[index].peer_maj23 = true;
     } else {
-      auto new_votes_by_block = block_votes::new_block_votes(true, val_set->size());
-      votes_by_block[block_key] = new_votes_by_block;
+      add_block_votes(block_id_, hash, true);
     }
     return {};
   }
@@ -224,12 +205,12 @@ struct vote_set {
 
   bool has_two_thirds_any() {
     std::scoped_lock g(mtx);
-    return sum > val_set->total_voting_power * 2 / 3;
+    return quorum > 0 && sum >= quorum;
   }
 
   bool has_all() {
     std::scoped_lock g(mtx);
-    return sum == val_set->total_voting_power;
+    return sum == total_voting_power;
   }
 
   /**
@@ -237,9 +218,6 @@ struct vote_set {
    */
   std::optional<p2p::block_id> two_thirds_majority() {
     std::scoped_lock g(mtx);
-    // if (maj23.has_value())
-    //  return maj23;
-    // return {};
     return maj23;
   }
 
@@ -259,13 +237,20 @@ struct vote_set {
     for (auto i = 0; auto& vote : votes) {
       auto commit_sig_ = (vote) ? vote->to_commit_sig() : commit_sig::new_commit_sig_absent();
       // If block_id exists but does not match, exclude sig
-      if (commit_sig_.for_block() && (vote->block_id_ != maj23)) {
+      if (commit_sig_.for_block() && vote_blocks[i] != maj23_index) {
         commit_sig_ = commit_sig::new_commit_sig_absent();
       }
       commit_sigs[i++] = commit_sig_;
     }
     return commit::new_commit(height, round, maj23.value(), commit_sigs);
   }
+
+private:
+  static size_t hash_block_id(const p2p::block_id& block_id_);
+  int32_t find_block_votes(const p2p::block_id& block_id_, size_t hash) const;
+  int32_t add_block_votes(const p2p::block_id& block_id_, size_t hash, bool peer_maj23);
+  std::shared_ptr<vote> get_vote(int32_t val_index, int32_t block_index) const;
+  void set_vote(int32_t val_index, int32_t block_index, std::shared_ptr<vote> vote_);
 };
 
 struct nil_vote_set : vote_set {
@@ -21,6 +21,8 @@ struct consensus_version {
   uint64_t block;
   uint64_t app;
 
+  bool operator==(const consensus_version&) const = default;
+
   static std::unique_ptr<::tendermint::version::Consensus> to_proto(const consensus_version& c) {
     auto ret = std::make_unique<::tendermint::version::Consensus>();
     ret->set_block(c.block);
@@ -7,10 +7,47 @@
 #include <noir/common/helper/go.h>
 #include <noir/consensus/wal.h>
 #include <noir/core/codec.h>
+#include <noir/crypto/hash/crc32c.h>
+#include <fc/log/logger_config.hpp>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 namespace noir::consensus {
 using ::fc::cfile;
 
+void encode_wal_frame_header(std::span<unsigned char, wal_frame_header_size> out, uint32_t crc, uint32_t len) {
+  for (auto i = 0; i < 4; ++i) {
+    out[i] = static_cast<unsigned char>(crc >> (8 * i));
+    out[4 + i] = static_cast<unsigned char>(len >> (8 * i));
+  }
+}
+
+std::pair<uint32_t, uint32_t> decode_wal_frame_header(std::span<const unsigned char, wal_frame_header_size> in) {
+  uint32_t crc = 0;
+  uint32_t len = 0;
+  for (auto i = 0; i < 4; ++i) {
+    crc |= static_cast<uint32_t>(in[i]) << (8 * i);
+    len |= static_cast<uint32_t>(in[4 + i]) << (8 * i);
+  }
+  return {crc, len};
+}
+
+void preallocate_wal_file(const std::filesystem::path& path, size_t size) {
+#if defined(__linux__)
+  auto fd = ::open(path.c_str(), O_WRONLY);
+  if (fd < 0) {
+    return;
+  }
+  if (::fallocate(fd, FALLOC_FL_KEEP_SIZE, 0, static_cast<off_t>(size)) != 0) {
+    dlog(fmt::format("unable to preallocate wal file: {}", path.string()));
+  }
+  ::close(fd);
+#endif
+}
+
 wal_decoder::wal_decoder(const std::string& full_path): file_(std::make_unique<::fc::cfile>()) {
   file_->set_file_path(full_path);
   file_->open(cfile::update_rw_mode); // TODO: handle panic
@@ -19,25 +56,19 @@ wal_decoder::wal_decoder(const std::string& full_path): file_(std::make_unique<:
 wal_decoder::result wal_decoder::decode(timed_wal_message& msg) {
   std::scoped_lock g(mtx_);
   try {
-    {
-      Bytes crc(4);
-      file_->read(reinterpret_cast<char*>(crc.data()), crc.size());
-      // TODO: check CRC32
-    }
-    size_t len;
-    {
-      Bytes len_(4);
-      file_->read(reinterpret_cast<char*>(len_.data()), len_.size());
-      len = stoull(to_hex(len_), nullptr, 16);
-      if (len > wal_file_manager::max_msg_size_bytes) {
-        return result::corrupted;
-      }
+    std::array<unsigned char, wal_frame_header_size> hdr;
+    file_->read(reinterpret_cast<char*>(hdr.data()), hdr.size());
+    auto [crc, len] = decode_wal_frame_header(hdr);
+    if (len > wal_file_manager::max_msg_size_bytes) {
+      return result::corrupted;
     }
-    {
-      noir::Bytes dat(len);
-      file_->read(reinterpret_cast<char*>(dat.data()), len);
-      msg = noir::decode<timed_wal_message>(dat);
+    noir::Bytes dat(len);
+    file_->read(reinterpret_cast<char*>(dat.data()), len);
+    if (crypto::Crc32c()(dat) != crc) {
+      elog("wal frame checksum mismatch: ${path}", ("path", file_->get_file_path().string()));
+      return result::corrupted;
     }
+    msg = noir::decode<timed_wal_message>(dat);
   } catch (...) {
     if (file_->eof()) {
       return result::eof;
@@ -48,13 +79,58 @@ wal_decoder::result wal_decoder::decode(timed_wal_message& msg) {
   return result::success;
 }
 
+void wal_decoder::seek(size_t offset) {
+  std::scoped_lock g(mtx_);
+  file_->seek(offset);
+}
+
+size_t wal_decoder::tell() {
+  std::scoped_lock g(mtx_);
+  return file_->tellp();
+}
+
 wal_encoder::wal_encoder(const std::string& full_path): file_(std::make_unique<::fc::cfile>()) {
   file_->set_file_path(full_path);
   file_->open(cfile::create_or_update_rw_mode); // TODO: handle panic
 }
 
 bool wal_encoder::encode(const timed_wal_message& msg, size_t& size) {
+  size_t offset;
+  return encode(msg, size, offset);
+}
+
+bool wal_encoder::encode(const timed_wal_message& msg, size_t& size, size_t& offset) {
   size = 0;
+  auto frame = encode_frame(msg);
+  if (!frame) {
+    return false;
+  }
+  if (!write_frame(*frame, offset)) {
+    return false;
+  }
+  size = frame->size();
+  return true;
+}
+
+std::optional<Bytes> wal_encoder::encode_frame(const timed_wal_message& msg) {
+  auto len = noir::encode_size(msg);
+  if (len > wal_file_manager::max_msg_size_bytes) { // TODO: handle error
+    elog("msg is too big: ${length} bytes, max: ${maxMsgSizeBytes} bytes",
+      ("length", len)("maxMsgSizeBytes", wal_file_manager::max_msg_size_bytes));
+    return std::nullopt;
+  }
+
+  // encode the message right behind the header so the whole frame goes out in a single write
+  Bytes buf(wal_frame_header_size + len);
+  auto dat = std::span(buf.data() + wal_frame_header_size, len);
+  datastream<unsigned char> ds(dat);
+  ds << msg;
+  encode_wal_frame_header(
+    std::span<unsigned char, wal_frame_header_size>(buf.data(), wal_frame_header_size), crypto::Crc32c()(dat), len);
+  return buf;
+}
+
+bool wal_encoder::write_frame(std::span<const unsigned char> frame, size_t& offset) {
   std::scoped_lock g(mtx_);
   auto is_closed = !file_->is_open();
   if (is_closed) {
@@ -72,21 +148,9 @@ bool wal_encoder::encode(const timed_wal_message& msg, size_t& size) {
     }
   });
 
-  auto dat = noir::encode(msg);
-  if (dat.size() > wal_file_manager::max_msg_size_bytes) { // TODO: handle error
-    elog("msg is too big: ${length} bytes, max: ${maxMsgSizeBytes} bytes",
-      ("length", dat.size())("maxMsgSizeBytes", wal_file_manager::max_msg_size_bytes));
-    return false;
-  }
-
-  Bytes crc(4); // TODO: CRC32
-  Bytes buf = crc;
-  Bytes len_hdr = from_hex(fmt::format("{:08x}", static_cast<uint32_t>(dat.size()))); // TODO: optimize
-  buf.raw().insert(buf.end(), len_hdr.begin(), len_hdr.end());
-  buf.raw().insert(buf.end(), dat.begin(), dat.end());
-
-  file_->write(reinterpret_cast<const char*>(buf.data()), buf.size());
-  size = buf.size();
+  file_->write(reinterpret_cast<const char*>(frame.data()), frame.size());
+  // NOTE: file is opened in append mode, so the position is only meaningful after a write
+  offset = file_->tellp() - frame.size();
   return true;
 }
 
@@ -113,4 +177,225 @@ size_t wal_encoder::size() {
   return file_->tellp(); // TODO: handle exception
 }
 
+/// \brief persisted form of the height index
+struct wal_height_index {
+  int64_t last_index;
+  std::map<int64_t, wal_index_entry> entries;
+};
+
+void wal_file_manager::index_wal_file(int64_t index) {
+  wal_decoder dec{full_path(dir_path_, index).string()};
+  timed_wal_message msg{};
+  auto offset = dec.tell();
+  while (true) {
+    auto ret = dec.decode(msg);
+    if (ret == wal_decoder::result::eof) {
+      break;
+    }
+    if (ret == wal_decoder::result::success) {
+      if (auto* ptr = std::get_if<end_height_message>(&msg.msg.msg); ptr) {
+        height_index_[ptr->height] = {index, offset};
+      }
+    }
+    offset = dec.tell();
+  }
+}
+
+void wal_file_manager::load_height_index() {
+  bool updated = false;
+  {
+    std::scoped_lock g(index_mtx_);
+    height_index_.clear();
+    last_indexed_ = min_index - 1;
+    index_complete_ = true;
+    try {
+      if (std::filesystem::exists(index_path())) {
+        cfile file;
+        file.set_file_path(index_path());
+        file.open(cfile::update_rw_mode);
+        std::array<unsigned char, wal_frame_header_size> hdr;
+        file.read(reinterpret_cast<char*>(hdr.data()), hdr.size());
+        auto [crc, len] = decode_wal_frame_header(hdr);
+        check(len + wal_frame_header_size == std::filesystem::file_size(index_path()), "size mismatch");
+        Bytes dat(len);
+        file.read(reinterpret_cast<char*>(dat.data()), len);
+        check(crypto::Crc32c()(dat) == crc, "checksum mismatch");
+        auto index = noir::decode<wal_height_index>(dat);
+        height_index_ = std::move(index.entries);
+        last_indexed_ = std::min(index.last_index, current_index - 1);
+      }
+    } catch (...) {
+      wlog("wal height index is corrupted; rebuilding: ${path}", ("path", index_path().string()));
+      height_index_.clear();
+      last_indexed_ = min_index - 1;
+    }
+    std::erase_if(height_index_,
+      [this](const auto& e) { return e.second.index < min_index || e.second.index > last_indexed_; });
+
+    // catch up on rolled files written after the index was saved, then on the head file
+    for (auto index = std::max(last_indexed_ + 1, min_index); index < current_index; ++index) {
+      try {
+        index_wal_file(index);
+      } catch (...) {
+        wlog("unable to index wal file: ${path}", ("path", full_path(dir_path_, index).string()));
+        index_complete_ = false;
+      }
+      // only files indexed without a gap are covered by the persisted index; the rest is retried on restart
+      if (index_complete_) {
+        last_indexed_ = index;
+        updated = true;
+      }
+    }
+    try {
+      index_wal_file(current_index);
+    } catch (...) {
+      wlog("unable to index wal file: ${path}", ("path", head_path_.string()));
+      index_complete_ = false;
+    }
+  }
+  if (updated && !save_height_index()) {
+    wlog("failed to save wal height index");
+  }
+}
+
+bool wal_file_manager::prepare_next() {
+  {
+    std::scoped_lock g(mtx_);
+    if (next_encoder_) {
+      return true;
+    }
+  }
+  std::shared_ptr<wal_encoder> enc;
+  try {
+    // NOTE: a leftover from a previous run may contain garbage; always start from an empty file
+    std::filesystem::remove(next_path());
+    enc = std::make_shared<wal_encoder>(next_path().string());
+    preallocate_wal_file(next_path(), rotate_size_);
+  } catch (...) {
+    elog("unable to prepare next wal file: ${path}", ("path", next_path().string()));
+  }
+  std::scoped_lock g(mtx_);
+  if (!enc) {
+    return false;
+  }
+  next_encoder_ = std::move(enc);
+  has_next_.store(true, std::memory_order_release);
+  return true;
+}
+
+void wal_file_manager::rebuild_height_index() {
+  std::filesystem::remove(index_path());
+  load_height_index();
+}
+
+bool wal_file_manager::save_height_index() {
+  wal_height_index index;
+  {
+    std::scoped_lock g(index_mtx_);
+    index.last_index = last_indexed_;
+    for (const auto& [height, pos] : height_index_) {
+      if (pos.index <= last_indexed_) {
+        index.entries.emplace(height, pos);
+      }
+    }
+  }
+  auto len = noir::encode_size(index);
+  Bytes buf(wal_frame_header_size + len);
+  auto dat = std::span(buf.data() + wal_frame_header_size, len);
+  datastream<unsigned char> ds(dat);
+  ds << index;
+  encode_wal_frame_header(
+    std::span<unsigned char, wal_frame_header_size>(buf.data(), wal_frame_header_size), crypto::Crc32c()(dat), len);
+
+  // write to a temporary file first so that a crash never leaves a truncated index behind
+  auto tmp_path = index_path();
+  tmp_path += ".tmp";
+  try {
+    {
+      cfile file;
+      file.set_file_path(tmp_path);
+      file.open(cfile::truncate_rw_mode);
+      file.write(reinterpret_cast<const char*>(buf.data()), buf.size());
+      file.flush();
+      file.sync();
+    }
+    std::filesystem::rename(tmp_path, index_path());
+  } catch (...) {
+    return false;
+  }
+  return true;
+}
+
+void base_wal::start_writer() {
+  writer_ = std::thread([this]() {
+    fc::set_os_thread_name("wal-writer");
+    writer_loop();
+  });
+}
+
+void base_wal::stop_writer() {
+  if (!writer_.joinable()) {
+    return;
+  }
+  stopping_ = true;
+  write_signal_.fetch_add(1, std::memory_order_release);
+  write_signal_.notify_one();
+  writer_.join();
+}
+
+void base_wal::writer_loop() {
+  std::vector<write_request> batch;
+  while (true) {
+    // NOTE: load the signal before draining; a push that is not visible yet bumps it afterwards and wakes us up
+    auto signal = write_signal_.load(std::memory_order_acquire);
+    while (auto req = write_queue_.pop()) {
+      batch.push_back(std::move(*req));
+    }
+    if (batch.empty()) {
+      if (stopping_) {
+        break;
+      }
+      write_signal_.wait(signal, std::memory_order_acquire);
+      continue;
+    }
+    process_write_requests(batch);
+    batch.clear();
+  }
+}
+
+void base_wal::process_write_requests(std::vector<write_request>& batch) {
+  std::vector<bool> written(batch.size(), true);
+  bool need_sync = false;
+  for (size_t i = 0; i < batch.size(); ++i) {
+    auto& req = batch[i];
+    need_sync |= req.done.has_value();
+    if (req.frame.empty()) {
+      continue;
+    }
+    if (!file_manager_->update()) {
+      elog("Failed to rotate wal file");
+    }
+    prepare_next_wal_file();
+    auto [enc, index] = file_manager_->get_current_wal_encoder();
+    size_t offset;
+    if (!enc->write_frame(req.frame, offset)) {
+      elog("Error writing msg to consensus wal. WARNING: recover may not be possible for the current height");
+      written[i] = false;
+      continue;
+    }
+    if (req.end_height) {
+      file_manager_->add_end_height(*req.end_height, index, offset);
+    }
+    written_seq_.fetch_add(1, std::memory_order_acq_rel);
+  }
+
+  // a single flush and fsync covers every frame of the batch
+  bool synced = !need_sync || file_manager_->get_wal_encoder()->flush_and_sync();
+  for (size_t i = 0; i < batch.size(); ++i) {
+    if (batch[i].done) {
+      batch[i].done->set_value(written[i] && synced);
+    }
+  }
+}
+
 } // namespace noir::consensus
@@ -5,6 +5,7 @@
 //
 #pragma once
 
+#include <noir/common/mpsc_queue.h>
 #include <noir/common/thread_pool.h>
 #include <noir/consensus/common.h>
 #include <noir/consensus/protocol.h>
@@ -13,7 +14,12 @@
 #include <boost/asio/steady_timer.hpp>
 #include <boost/filesystem/operations.hpp>
 #include <fc/io/cfile.hpp>
+#include <condition_variable>
 #include <filesystem>
+#include <future>
+#include <map>
+#include <optional>
+#include <thread>
 
 namespace noir::consensus {
 
@@ -44,6 +50,20 @@ struct wal_search_options {
   bool ignore_data_corruption_errors;
 };
 
+/// \brief size of the frame header preceding each WAL message: 4 Bytes CRC32C + 4 Bytes length
+constexpr size_t wal_frame_header_size = 8;
+
+/// \brief writes a WAL frame header; both fields are stored in little-endian order
+/// \param[out] out header buffer
+/// \param[in] crc CRC32C of the message body
+/// \param[in] len length of the message body
+void encode_wal_frame_header(std::span<unsigned char, wal_frame_header_size> out, uint32_t crc, uint32_t len);
+
+/// \brief parses a WAL frame header
+/// \param[in] in header buffer
+/// \return pair of CRC32C and length of the message body
+std::pair<uint32_t, uint32_t> decode_wal_frame_header(std::span<const unsigned char, wal_frame_header_size> in);
+
 /// \brief A WALDecoder reads and decodes custom-encoded WAL messages from an input
 /// stream. See WALEncoder for the format used.
 /// It will also compare the checksums and make sure data size is equal to the
@@ -62,13 +82,21 @@ public:
   /// \return result
   result decode(timed_wal_message& msg);
 
+  /// \brief moves the read position to the given byte offset
+  /// \param[in] offset
+  void seek(size_t offset);
+
+  /// \brief gets the current read position
+  /// \return byte offset
+  size_t tell();
+
 private:
   std::unique_ptr<::fc::cfile> file_;
   std::mutex mtx_;
 };
 
 /// \brief A WALEncoder writes custom-encoded WAL messages to an output stream.
-/// Format: 4 Bytes CRC sum + 4 Bytes length + arbitrary-length value
+/// Format: 4 Bytes CRC32C of value + 4 Bytes length + arbitrary-length value (header fields in little-endian)
 class wal_encoder {
   friend class wal_file_manager;
 
@@ -82,6 +110,24 @@ public:
   /// \return true on success, false otherwise
   bool encode(const timed_wal_message& msg, size_t& size);
 
+  /// \brief same as above, additionally reports the byte offset the frame was written at
+  /// \param[in] msg
+  /// \param[out] size written Bytes size
+  /// \param[out] offset byte offset of the written frame
+  /// \return true on success, false otherwise
+  bool encode(const timed_wal_message& msg, size_t& size, size_t& offset);
+
+  /// \brief encodes msg into a complete frame (header + value) without writing it
+  /// \param[in] msg
+  /// \return encoded frame, std::nullopt if msg is too big
+  static std::optional<Bytes> encode_frame(const timed_wal_message& msg);
+
+  /// \brief appends a frame produced by encode_frame to the stream
+  /// \param[in] frame
+  /// \param[out] offset byte offset of the written frame
+  /// \return true on success, false otherwise
+  bool write_frame(std::span<const unsigned char> frame, size_t& offset);
+
   /// \brief flushes and fsync the underlying group's data to disk.
   /// \return true on success, false otherwise
   bool flush_and_sync();
@@ -95,6 +141,18 @@ private:
   std::mutex mtx_;
 };
 
+/// \brief reserves disk space for a wal file without changing its visible size
+/// Readers therefore never see the preallocated area. No-op on platforms without fallocate.
+/// \param[in] path
+/// \param[in] size number of bytes to reserve
+void preallocate_wal_file(const std::filesystem::path& path, size_t size);
+
+/// \brief position of an end_height_message inside the WAL
+struct wal_index_entry {
+  int64_t index; ///< index of the WAL file
+  uint64_t offset; ///< byte offset of the frame containing end_height_message
+};
+
 /// \brief WALFileManager manages wal file and mutex
 /// The first file to be written in the WALFileManager.Dir is the head file.
 ///
@@ -115,6 +173,14 @@ private:
 ///	- <HeadPath>.001   // Second rolled file
 ///	- ...
 ///	- <HeadPath>       // New head path
+///
+/// A height index sidecar (<HeadPath>.idx) maps each end_height_message of the rolled files to its file index and
+/// byte offset, so that searching for a height does not need to decode every message. The index is persisted on
+/// rotation; entries of the head file are kept in memory and recovered by scanning the head file on startup.
+/// A missing or corrupted index is rebuilt by scanning the rolled files.
+///
+/// Disk space for the head file is preallocated up to the rotation size. prepare_next() creates and preallocates
+/// the next head file (<HeadPath>.next) ahead of time, so that rotation only renames files.
 class wal_file_manager {
 public:
   wal_file_manager(const std::string& dir, const std::string& file_name, size_t num_file, size_t rotate_size)
@@ -127,6 +193,8 @@ public:
     }
     current_index = max_index;
     encoder_ = get_wal_encoder(current_index);
+    preallocate_wal_file(head_path_, rotate_size_);
+    load_height_index();
   }
 
   /// \brief rotate wal file if necessary
@@ -153,6 +221,13 @@ public:
     return make_shared<wal_encoder>(full_path(dir_path_, index).string());
   }
 
+  /// \brief gets current using wal_encoder along with the index of its wal file
+  /// \return pair of wal_encoder and index
+  std::pair<std::shared_ptr<wal_encoder>, int64_t> get_current_wal_encoder() {
+    std::scoped_lock g(mtx_);
+    return {encoder_, current_index};
+  }
+
   /// \brief gets wal_decoder of wal file of given index
   /// \param[in] index
   /// \return shared_ptr of wal_decoder
@@ -161,6 +236,46 @@ public:
     return make_shared<wal_decoder>(full_path(dir_path_, index).string());
   }
 
+  /// \brief records the position of an end_height_message in the height index
+  /// \param[in] height height of end_height_message
+  /// \param[in] index index of wal file the message was written to
+  /// \param[in] offset byte offset of the frame
+  void add_end_height(int64_t height, int64_t index, uint64_t offset) {
+    std::scoped_lock g(index_mtx_);
+    height_index_[height] = {index, offset};
+  }
+
+  /// \brief looks up the position of end_height_message for given height in the height index
+  /// \param[in] height
+  /// \return position if indexed, std::nullopt otherwise
+  std::optional<wal_index_entry> find_end_height(int64_t height) {
+    std::scoped_lock g(index_mtx_);
+    if (auto it = height_index_.find(height); it != height_index_.end() && it->second.index >= min_index) {
+      return it->second;
+    }
+    return std::nullopt;
+  }
+
+  /// \brief checks if every wal file was indexed successfully
+  /// \return false if the height index may be missing entries
+  bool height_index_complete() {
+    std::scoped_lock g(index_mtx_);
+    return index_complete_;
+  }
+
+  /// \brief drops the persisted height index and rebuilds it by scanning every wal file
+  void rebuild_height_index();
+
+  /// \brief creates and preallocates the file which becomes the head file on next rotation
+  /// Must not be called concurrently with itself; rotation may run concurrently.
+  /// \return true on success, false otherwise
+  bool prepare_next();
+
+  /// \brief checks if the next head file has been prepared
+  bool has_next() const {
+    return has_next_.load(std::memory_order_acquire);
+  }
+
   std::filesystem::path full_path(std::filesystem::path dir_path, int64_t index, bool implicit = true) {
     if (implicit && index == current_index) {
       return head_path_;
@@ -177,6 +292,8 @@ public:
   int64_t max_index = -1;
 
   static constexpr std::string_view corrupted_postfix = ".CORRUPTED";
+  static constexpr std::string_view index_postfix = ".idx";
+  static constexpr std::string_view next_postfix = ".next";
   // FIXME: below constants are not correct
   static constexpr size_t max_msg_size = 1048576; // 1 MB; NOTE: keep in sync with types.PartSet sizes.
   static constexpr size_t max_msg_size_bytes = max_msg_size + 24; // time.Time + max consensus msg size
@@ -191,6 +308,38 @@ private:
   std::mutex mtx_;
   int64_t current_index = -1; ///< indicates implicit index of current opened file
 
+  // next head file
+  std::shared_ptr<wal_encoder> next_encoder_;
+  std::atomic<bool> has_next_{false};
+
+  std::filesystem::path next_path() const {
+    auto ret = head_path_;
+    ret += next_postfix;
+    return ret;
+  }
+
+  // height index
+  std::map<int64_t, wal_index_entry> height_index_;
+  int64_t last_indexed_ = -1; ///< highest rolled file covered by the persisted height index
+  bool index_complete_ = true; ///< false if some wal file failed to be indexed
+  std::mutex index_mtx_;
+
+  std::filesystem::path index_path() const {
+    auto ret = head_path_;
+    ret += index_postfix;
+    return ret;
+  }
+
+  /// \brief adds end_height_messages of wal file of given index to the height index
+  void index_wal_file(int64_t index);
+
+  /// \brief loads the persisted height index and catches up on files not covered by it
+  void load_height_index();
+
+  /// \brief persists height index of rolled files
+  /// \return true on success, false otherwise
+  bool save_height_index();
+
   int64_t index_from_file_name(const std::filesystem::path& file_name) {
     auto wal_name = head_name_.string();
     size_t len = wal_name.length();
@@ -202,7 +351,8 @@ private:
     if (sub_name.empty()) { // head file
       return -1;
     }
-    if (sub_name.compare(corrupted_postfix) == 0) {
+    if (sub_name.compare(corrupted_postfix) == 0 || sub_name.starts_with(index_postfix) ||
+      sub_name.compare(next_postfix) == 0) {
       return -1;
     }
     return static_cast<int64_t>(std::stoull(name.substr(len)));
@@ -229,8 +379,28 @@ private:
         wlog(fmt::format("wal file for new index {} already exists: {}", current_index, new_file_path.string()));
       }
       std::filesystem::rename(file_->get_file_path().string(), new_file_path);
+      {
+        std::scoped_lock g_index(index_mtx_);
+        std::erase_if(height_index_, [this](const auto& e) { return e.second.index < min_index; });
+        // a file which failed to be indexed must not be covered by the persisted index
+        if (index_complete_) {
+          last_indexed_ = current_index;
+        }
+      }
+      if (!save_height_index()) {
+        wlog("failed to save wal height index; it will be rebuilt on restart");
+      }
       current_index = ++max_index;
-      encoder_ = get_wal_encoder(current_index);
+      if (next_encoder_) {
+        // promote the prepared file; its descriptor stays valid across the rename
+        std::filesystem::rename(next_path(), head_path_);
+        next_encoder_->file_->set_file_path(head_path_);
+        encoder_ = std::move(next_encoder_);
+        has_next_.store(false, std::memory_order_release);
+      } else {
+        encoder_ = get_wal_encoder(current_index);
+        preallocate_wal_file(head_path_, rotate_size_);
+      }
       ilog(fmt::format("created wal file for new index: {}", current_index));
     } catch (...) {
       return false;
@@ -297,47 +467,95 @@ public:
   virtual bool on_stop() = 0;
 };
 
+/// \brief determines how base_wal makes written messages durable
+enum class wal_sync_mode {
+  immediate, ///< every write_sync/flush_and_sync issues its own flush and fsync
+  group_commit, ///< concurrent write_sync/flush_and_sync callers share a single flush and fsync
+  async_writer, ///< a dedicated writer thread appends frames and reports durability through futures
+};
+
 /// \brief Write ahead logger writes msgs to disk before they are processed.
 /// Can be used for crash-recovery and deterministic replay.
+/// In group commit mode, concurrent write_sync/flush_and_sync callers share a single flush and fsync per batch
+/// instead of issuing one each.
+/// In async writer mode, callers only encode messages and push the frames into a lock-free queue; a single writer
+/// thread appends them, rotates files and fsyncs once per batch, so write_sync callers block only until the batch
+/// containing their own frame is durable.
 /// \todo currently the wal is overwritten during replay catchup, give it a mode so it's either reading or
 /// appending - must read to end to start appending again.
 class base_wal : public wal {
 public:
   base_wal(const base_wal&) = delete; // do not allow copy
-  base_wal(const std::string& dir, const std::string& file_name, size_t num_file, size_t rotate_size)
+  base_wal(const std::string& dir,
+    const std::string& file_name,
+    size_t num_file,
+    size_t rotate_size,
+    wal_sync_mode mode = wal_sync_mode::immediate)
     : file_manager_(std::make_unique<wal_file_manager>(dir, file_name, num_file, rotate_size)),
-      flush_interval(std::chrono::seconds{2}) {
+      flush_interval(std::chrono::seconds{2}),
+      mode_(mode) {
     thread_pool.emplace("consensus", thread_pool_size);
     {
       // std::scoped_lock g(flush_ticker_mtx);
       flush_ticker = std::make_unique<boost::asio::steady_timer>(thread_pool->get_executor());
     }
+    if (mode_ == wal_sync_mode::async_writer) {
+      start_writer();
+    }
   }
   ~base_wal() override {
     if (flush_ticker) {
       flush_ticker->cancel();
       flush_ticker.reset();
     }
-    file_manager_.reset();
+    stop_writer();
     if (thread_pool) {
       thread_pool->stop();
     }
+    file_manager_.reset();
   }
 
   bool write(const wal_message& msg) override {
+    if (mode_ == wal_sync_mode::async_writer) {
+      auto frame = wal_encoder::encode_frame(timed_wal_message{.time = get_time(), .msg = msg});
+      if (!frame) {
+        elog("Error writing msg to consensus wal. WARNING: recover may not be possible for the current height");
+        return false;
+      }
+      enqueue(std::move(*frame), end_height_of(msg), false);
+      return true;
+    }
+
     size_t len;
     if (!file_manager_->update()) {
       elog("Failed to rotate wal file");
     }
-    auto enc = file_manager_->get_wal_encoder();
-    if (!enc->encode(timed_wal_message{.time = get_time(), .msg = msg}, len) || len == 0) {
+    prepare_next_wal_file();
+    auto [enc, index] = file_manager_->get_current_wal_encoder();
+    size_t offset;
+    if (!enc->encode(timed_wal_message{.time = get_time(), .msg = msg}, len, offset) || len == 0) {
       elog("Error writing msg to consensus wal. WARNING: recover may not be possible for the current height");
       return false;
     }
+    if (auto height = end_height_of(msg); height) {
+      file_manager_->add_end_height(*height, index, offset);
+    }
+    // NOTE: sequence is bumped only after the message is in the encoder buffer, so any sync that observes it
+    // is guaranteed to cover the message.
+    written_seq_.fetch_add(1, std::memory_order_acq_rel);
     return true;
   }
 
   bool write_sync(const wal_message& msg) override {
+    if (mode_ == wal_sync_mode::async_writer) {
+      if (!write_async(msg).get()) {
+        elog("WriteSync failed to write consensus wal.\n"
+             "\t\tWARNING: may result in creating alternative proposals / votes for the current height iff the node "
+             "restarted");
+        return false;
+      }
+      return true;
+    }
     if (!write(msg)) {
       return false;
     }
@@ -350,7 +568,27 @@ public:
     return true;
   }
 
+  /// \brief queues msg to the writer thread without waiting for it; only available in async writer mode
+  /// \param[in] msg
+  /// \return future which becomes true once msg is on disk, false if msg could not be written
+  std::future<bool> write_async(const wal_message& msg) {
+    check(mode_ == wal_sync_mode::async_writer, "write_async requires async writer mode");
+    auto frame = wal_encoder::encode_frame(timed_wal_message{.time = get_time(), .msg = msg});
+    if (!frame) {
+      std::promise<bool> failed;
+      failed.set_value(false);
+      return failed.get_future();
+    }
+    return enqueue(std::move(*frame), end_height_of(msg), true);
+  }
+
   bool flush_and_sync() override {
+    if (mode_ == wal_sync_mode::async_writer) {
+      return enqueue({}, std::nullopt, true).get();
+    }
+    if (mode_ == wal_sync_mode::group_commit) {
+      return group_sync(written_seq_.load(std::memory_order_acquire));
+    }
     return file_manager_->get_wal_encoder()->flush_and_sync();
   }
 
@@ -395,6 +633,91 @@ public:
   }
 
   std::shared_ptr<wal_decoder> search_for_end_height(int64_t height, wal_search_options options, bool& found) override {
+    if (file_manager_->min_index < 0 || file_manager_->max_index < 0) {
+      found = false;
+      return {nullptr};
+    }
+    auto pos = file_manager_->find_end_height(height);
+    if (!pos) {
+      // NOTE: a complete height index covers every wal file, so a missing entry means the height is not in the WAL
+      if (!file_manager_->height_index_complete()) {
+        return scan_for_end_height(height, options, found);
+      }
+      found = false;
+      return {nullptr};
+    }
+    try {
+      auto decoder = file_manager_->get_wal_decoder(pos->index);
+      decoder->seek(pos->offset);
+      timed_wal_message msg{};
+      if (decoder->decode(msg) == wal_decoder::result::success) {
+        if (auto* ptr = std::get_if<end_height_message>(&msg.msg.msg); ptr && ptr->height == height) {
+          found = true;
+          return decoder;
+        }
+      }
+    } catch (...) {
+    }
+    // wal file was modified behind our back; fall back to scanning
+    wlog("stale wal height index entry for height=${height}", ("height", height));
+    return scan_for_end_height(height, options, found);
+  }
+
+  bool set_flush_interval(std::chrono::system_clock::duration interval) {
+    // TODO: should flush ticker restart?
+    flush_interval = interval;
+    return false;
+  }
+
+  wal_sync_mode sync_mode() const {
+    return mode_;
+  }
+
+private:
+  /// \brief frame waiting for the writer thread
+  struct write_request {
+    Bytes frame; ///< empty for a pure sync request
+    std::optional<int64_t> end_height; ///< set if frame holds end_height_message
+    std::optional<std::promise<bool>> done; ///< set if the requester waits for durability
+  };
+
+  static std::optional<int64_t> end_height_of(const wal_message& msg) {
+    if (auto* ptr = std::get_if<end_height_message>(&msg.msg); ptr) {
+      return ptr->height;
+    }
+    return std::nullopt;
+  }
+
+  std::future<bool> enqueue(Bytes frame, std::optional<int64_t> end_height, bool sync) {
+    write_request req{.frame = std::move(frame), .end_height = end_height};
+    std::future<bool> ret;
+    if (sync) {
+      ret = req.done.emplace().get_future();
+    }
+    write_queue_.push(std::move(req));
+    write_signal_.fetch_add(1, std::memory_order_release);
+    write_signal_.notify_one();
+    return ret;
+  }
+
+  void start_writer();
+  void stop_writer();
+  void writer_loop();
+  void process_write_requests(std::vector<write_request>& batch);
+
+  /// \brief prepares next wal file in background, so that the following rotation does not create a file
+  void prepare_next_wal_file() {
+    if (file_manager_->has_next() || preparing_next_.exchange(true)) {
+      return;
+    }
+    boost::asio::post(thread_pool->get_executor(), [this]() {
+      file_manager_->prepare_next();
+      preparing_next_ = false;
+    });
+  }
+
+  /// \brief searches for the end_height_message by decoding wal files from the newest one
+  std::shared_ptr<wal_decoder> scan_for_end_height(int64_t height, wal_search_options options, bool& found) {
     int64_t last_height_found{-1};
     auto max_index = file_manager_->max_index;
     auto min_index = file_manager_->min_index;
@@ -442,13 +765,36 @@ public:
     return {nullptr};
   }
 
-  bool set_flush_interval(std::chrono::system_clock::duration interval) {
-    // TODO: should flush ticker restart?
-    flush_interval = interval;
-    return false;
+  /// \brief waits until every message up to the given sequence is durable
+  /// The first caller to arrive becomes the leader and flushes everything written so far with a single fsync;
+  /// callers arriving while the sync is in progress wait for it and return without touching the disk if the
+  /// batch already covered their messages.
+  /// \param[in] target sequence number of the last message which must be durable
+  /// \return true on success, false otherwise
+  bool group_sync(uint64_t target) {
+    std::unique_lock g(sync_mtx_);
+    while (synced_seq_ < target) {
+      if (sync_in_progress_) {
+        sync_cv_.wait(g);
+        continue;
+      }
+      sync_in_progress_ = true;
+      auto batch = written_seq_.load(std::memory_order_acquire);
+      g.unlock();
+      auto ok = file_manager_->get_wal_encoder()->flush_and_sync();
+      g.lock();
+      sync_in_progress_ = false;
+      if (ok) {
+        synced_seq_ = std::max(synced_seq_, batch);
+      }
+      sync_cv_.notify_all();
+      if (!ok) {
+        return false;
+      }
+    }
+    return true;
   }
 
-private:
   std::unique_ptr<wal_file_manager> file_manager_;
   // flush ticker
   std::unique_ptr<boost::asio::steady_timer> flush_ticker;
@@ -456,6 +802,22 @@ private:
   uint16_t thread_pool_size = 2;
   std::optional<named_thread_pool> thread_pool;
 
+  wal_sync_mode mode_;
+  std::atomic<bool> preparing_next_{false};
+
+  // async writer
+  mpsc_queue<write_request> write_queue_;
+  std::atomic<uint64_t> write_signal_{0}; ///< bumped after each push; the writer thread waits on it
+  std::atomic<bool> stopping_{false};
+  std::thread writer_;
+
+  // group commit
+  std::atomic<uint64_t> written_seq_{0}; ///< number of messages handed to the encoder
+  uint64_t synced_seq_{0}; ///< number of messages known to be on disk; guarded by sync_mtx_
+  bool sync_in_progress_{false}; ///< guarded by sync_mtx_
+  std::mutex sync_mtx_;
+  std::condition_variable sync_cv_;
+
   std::function<void(boost::system::error_code)> process_flush_ticks = [this](boost::system::error_code ec) {
     if (ec == boost::asio::error::operation_aborted) {
       return;
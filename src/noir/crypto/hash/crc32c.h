@@ -0,0 +1,43 @@
+// This file is part of NOIR.
+//
+// Copyright (c) 2022 Haderech Pte. Ltd.
+// SPDX-License-Identifier: AGPL-3.0-or-later
+//
+#pragma once
+#include <noir/crypto/hash/hash.h>
+
+namespace noir::crypto {
+
+/// \brief generates crc32c (Castagnoli) checksum
+/// Uses SSE4.2 or ARMv8 CRC32 instructions when available, falls back to a table-driven implementation otherwise.
+/// \ingroup crypto
+struct Crc32c : public Hash<Crc32c> {
+  using Hash::update;
+
+  auto init() -> Crc32c&;
+  auto update(std::span<const unsigned char> in) -> Crc32c&;
+  void final(std::span<unsigned char> out);
+  auto final() -> uint32_t;
+
+  constexpr auto digest_size() const -> size_t {
+    return 4;
+  }
+
+  auto operator()(ByteSequence auto&& in) -> uint32_t {
+    return init().update(bytes_view(in)).final();
+  }
+
+private:
+  uint32_t state = 0xffffffff;
+};
+
+namespace detail {
+  /// \brief updates a crc32c state with the table-driven implementation, regardless of hardware support
+  /// Crc32c falls back to it only on CPUs without CRC32 instructions; exposed so that tests cover it everywhere.
+  /// \param crc running state, 0xffffffff for a new checksum
+  /// \param in input data
+  /// \return updated state; the checksum is its complement
+  uint32_t crc32c_portable(uint32_t crc, std::span<const unsigned char> in);
+} // namespace detail
+
+} // namespace noir::crypto
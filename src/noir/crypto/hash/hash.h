@@ -54,4 +54,12 @@ protected:
   Hash() = default;
 };
 
+/// \brief calculates hashes of many independent messages at once
+/// Implemented for Sha256, Keccak256 and Sha3_256, which compute several messages side by side in SIMD lanes when
+/// the CPU supports it, and one by one otherwise.
+/// \param in input messages
+/// \param out output array receiving the hash of in[i] at out[i]; must have the same size as in
+template<typename Hasher>
+void hash_many(std::span<const std::span<const unsigned char>> in, std::span<Bytes32> out);
+
 } // namespace noir::crypto
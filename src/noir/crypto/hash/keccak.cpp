@@ -3,12 +3,183 @@
 // Copyright (c) 2022 Haderech Pte. Ltd.
 // SPDX-License-Identifier: AGPL-3.0-or-later
 //
+#include <noir/common/check.h>
 #include <noir/crypto/hash/keccak.h>
+#include <noir/crypto/hash/sha3.h>
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define NOIR_KECCAK_AVX2
+#endif
 
 #define Keccak_HashInitialize_Keccak256(hashInstance) Keccak_HashInitialize(hashInstance, 1088, 512, 256, 0x01)
 
 namespace noir::crypto {
 
+namespace {
+
+  // bytes absorbed per permutation by keccak256 and sha3-256
+  constexpr size_t rate = 136;
+
+  size_t block_count(size_t size) {
+    return size / rate + 1;
+  }
+
+#if defined(NOIR_KECCAK_AVX2)
+#define NOIR_AVX2_TARGET __attribute__((target("avx2")))
+
+  constexpr uint64_t round_constants[24] = {0x0000000000000001, 0x0000000000008082, 0x800000000000808a,
+    0x8000000080008000, 0x000000000000808b, 0x0000000080000001, 0x8000000080008081, 0x8000000000008009,
+    0x000000000000008a, 0x0000000000000088, 0x0000000080008009, 0x000000008000000a, 0x000000008000808b,
+    0x800000000000008b, 0x8000000000008089, 0x8000000000008003, 0x8000000000008002, 0x8000000000000080,
+    0x000000000000800a, 0x800000008000000a, 0x8000000080008081, 0x8000000000008080, 0x0000000080000001,
+    0x8000000080008008};
+
+  // rotation of lane x + 5y, and the position it moves to, in rho and pi steps
+  constexpr int rotations[25] = {
+    0, 1, 62, 28, 27, 36, 44, 6, 55, 20, 3, 10, 43, 25, 39, 41, 45, 15, 21, 8, 18, 2, 61, 56, 14};
+  constexpr int positions[25] = {
+    0, 10, 20, 5, 15, 16, 1, 11, 21, 6, 7, 17, 2, 12, 22, 23, 8, 18, 3, 13, 14, 24, 9, 19, 4};
+
+  NOIR_AVX2_TARGET __m256i rotl4(__m256i x, int n) {
+    return n == 0 ? x : _mm256_or_si256(_mm256_slli_epi64(x, n), _mm256_srli_epi64(x, 64 - n));
+  }
+
+  // Keccak-f[1600] on 4 states, lane i of every state in the 64-bit lanes of a[i]
+  NOIR_AVX2_TARGET void permute4_avx2(__m256i (&a)[25]) {
+    for (auto round = 0; round < 24; ++round) {
+      __m256i c[5], b[25];
+#pragma GCC unroll 5
+      for (auto x = 0; x < 5; ++x)
+        c[x] = _mm256_xor_si256(
+          _mm256_xor_si256(_mm256_xor_si256(a[x], a[x + 5]), _mm256_xor_si256(a[x + 10], a[x + 15])), a[x + 20]);
+#pragma GCC unroll 5
+      for (auto x = 0; x < 5; ++x) {
+        auto d = _mm256_xor_si256(c[(x + 4) % 5], rotl4(c[(x + 1) % 5], 1));
+#pragma GCC unroll 5
+        for (auto y = 0; y < 25; y += 5)
+          a[x + y] = _mm256_xor_si256(a[x + y], d);
+      }
+#pragma GCC unroll 25
+      for (auto i = 0; i < 25; ++i)
+        b[positions[i]] = rotl4(a[i], rotations[i]);
+#pragma GCC unroll 5
+      for (auto y = 0; y < 25; y += 5) {
+#pragma GCC unroll 5
+        for (auto x = 0; x < 5; ++x)
+          a[x + y] = _mm256_xor_si256(b[x + y], _mm256_andnot_si256(b[(x + 1) % 5 + y], b[(x + 2) % 5 + y]));
+      }
+      a[0] = _mm256_xor_si256(a[0], _mm256_set1_epi64x(static_cast<int64_t>(round_constants[round])));
+    }
+  }
+
+  uint64_t load64(const unsigned char* p) {
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+  }
+
+  // blocks of a message being hashed in a lane: full blocks read in place, then the padded tail
+  struct lane_blocks {
+    lane_blocks() = default;
+    lane_blocks(std::span<const unsigned char> in, unsigned char suffix): data(in.data()), full(in.size() / rate) {
+      auto rest = in.size() % rate;
+      std::memset(tail, 0, sizeof(tail));
+      std::memcpy(tail, data + full * rate, rest);
+      tail[rest] ^= suffix;
+      tail[rate - 1] ^= 0x80;
+    }
+
+    const unsigned char* block(size_t i) const {
+      return i < full ? data + i * rate : tail;
+    }
+
+    const unsigned char* data{};
+    size_t full{};
+    unsigned char tail[rate];
+  };
+
+  NOIR_AVX2_TARGET void hash_lanes4(
+    const std::span<const unsigned char>* const (&in)[4], unsigned char* const (&out)[4], unsigned char suffix) {
+    __m256i a[25];
+    for (auto& lane : a)
+      lane = _mm256_setzero_si256();
+    lane_blocks lanes[4];
+    for (auto l = 0; l < 4; ++l)
+      lanes[l] = lane_blocks(*in[l], suffix);
+    for (size_t i = 0, n = block_count(in[0]->size()); i < n; ++i) {
+      const unsigned char* blocks[4];
+      for (auto l = 0; l < 4; ++l)
+        blocks[l] = lanes[l].block(i);
+#pragma GCC unroll 17
+      for (size_t j = 0; j < rate / 8; ++j)
+        a[j] = _mm256_xor_si256(a[j],
+          _mm256_setr_epi64x(static_cast<int64_t>(load64(blocks[0] + 8 * j)),
+            static_cast<int64_t>(load64(blocks[1] + 8 * j)), static_cast<int64_t>(load64(blocks[2] + 8 * j)),
+            static_cast<int64_t>(load64(blocks[3] + 8 * j))));
+      permute4_avx2(a);
+    }
+    alignas(32) uint64_t words[4][4];
+    for (auto j = 0; j < 4; ++j)
+      _mm256_store_si256(reinterpret_cast<__m256i*>(words[j]), a[j]);
+    for (auto l = 0; l < 4; ++l)
+      for (auto j = 0; j < 4; ++j)
+        std::memcpy(out[l] + 8 * j, &words[j][l], 8);
+  }
+
+  bool has_avx2() {
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+  }
+#endif
+
+  // hashes messages 4 at a time in AVX2 lanes and the rest one by one; suffix holds the domain separation bits
+  // preceding the padding, 0x01 for keccak256 and 0x06 for sha3-256
+  void hash_many_lanes(std::span<const std::span<const unsigned char>> in,
+    std::span<Bytes32> out,
+    unsigned char suffix,
+    void (*hash_one)(std::span<const unsigned char>, Bytes32&)) {
+    check(in.size() == out.size(), "hash_many requires an output for every message");
+    size_t lanes = 1;
+#if defined(NOIR_KECCAK_AVX2)
+    if (has_avx2())
+      lanes = 4;
+#endif
+
+    // lanes advance block by block together, so messages of the same number of blocks are grouped
+    std::vector<size_t> blocks(in.size());
+    std::transform(in.begin(), in.end(), blocks.begin(), [](auto& m) { return block_count(m.size()); });
+    std::vector<size_t> order(in.size());
+    std::iota(order.begin(), order.end(), 0);
+    if (lanes > 1 && std::adjacent_find(blocks.begin(), blocks.end(), std::not_equal_to<>()) != blocks.end())
+      std::stable_sort(order.begin(), order.end(), [&](auto a, auto b) { return blocks[a] < blocks[b]; });
+
+    for (size_t i = 0; i < order.size();) {
+      auto end = i;
+      while (end < order.size() && blocks[order[end]] == blocks[order[i]])
+        ++end;
+#if defined(NOIR_KECCAK_AVX2)
+      for (; lanes == 4 && end - i >= 4; i += 4) {
+        const std::span<const unsigned char>* lane_in[4];
+        unsigned char* lane_out[4];
+        for (auto l = 0; l < 4; ++l) {
+          lane_in[l] = &in[order[i + l]];
+          lane_out[l] = out[order[i + l]].data();
+        }
+        hash_lanes4(lane_in, lane_out, suffix);
+      }
+#endif
+      for (; i < end; ++i)
+        hash_one(in[order[i]], out[order[i]]);
+    }
+  }
+
+} // namespace
+
 auto Keccak256::init() -> Keccak256& {
   if (!ctx) {
     ctx.emplace();
@@ -29,4 +200,27 @@ void Keccak256::final(std::span<unsigned char> out) {
   Keccak_HashFinal(&*ctx, (BitSequence*)out.data());
 }
 
+void keccak256(std::span<const unsigned char> in, Bytes32& out) {
+  Keccak_HashInstance ctx;
+  Keccak_HashInitialize_Keccak256(&ctx);
+  Keccak_HashUpdate(&ctx, (BitSequence*)in.data(), in.size() * 8);
+  Keccak_HashFinal(&ctx, (BitSequence*)out.data());
+}
+
+auto keccak256(std::span<const unsigned char> in) -> Bytes32 {
+  Bytes32 out;
+  keccak256(in, out);
+  return out;
+}
+
+template<>
+void hash_many<Keccak256>(std::span<const std::span<const unsigned char>> in, std::span<Bytes32> out) {
+  hash_many_lanes(in, out, 0x01, keccak256);
+}
+
+template<>
+void hash_many<Sha3_256>(std::span<const std::span<const unsigned char>> in, std::span<Bytes32> out) {
+  hash_many_lanes(in, out, 0x06, sha3_256);
+}
+
 } // namespace noir::crypto
@@ -31,4 +31,19 @@ private:
   std::optional<Keccak_HashInstance> ctx;
 };
 
+/// \brief calculates keccak256 hash of input data into a fixed-size array, without heap allocation
+/// \param in input data
+/// \param out output array
+/// \ingroup crypto
+void keccak256(std::span<const unsigned char> in, Bytes32& out);
+
+/// \brief calculates and returns keccak256 hash of input data, without heap allocation
+/// \param in input data
+/// \return array containing hash
+/// \ingroup crypto
+auto keccak256(std::span<const unsigned char> in) -> Bytes32;
+
+template<>
+void hash_many<Keccak256>(std::span<const std::span<const unsigned char>> in, std::span<Bytes32> out);
+
 } // namespace noir::crypto
@@ -8,7 +8,9 @@
 namespace noir::crypto {
 
 auto Sha256::init() -> Sha256& {
-  MessageDigest::init(EVP_sha256());
+  // EVP_sha256() would make OpenSSL look up the provider implementation on every initialization
+  static const EVP_MD* type = EVP_MD_fetch(nullptr, "SHA256", nullptr);
+  MessageDigest::init(type);
   return *this;
 }
 
@@ -28,4 +30,14 @@ auto Sha256::digest_size() const -> size_t {
   return MessageDigest::digest_size(EVP_sha256());
 }
 
+void sha256(std::span<const unsigned char> in, Bytes32& out) {
+  Sha256().init().update(in).final(std::span(out.data(), out.size()));
+}
+
+auto sha256(std::span<const unsigned char> in) -> Bytes32 {
+  Bytes32 out;
+  sha256(in, out);
+  return out;
+}
+
 } // namespace noir::crypto
@@ -6,6 +6,7 @@
 #pragma once
 #include <noir/crypto/hash/hash.h>
 #include <noir/crypto/openssl/message_digest.h>
+#include <array>
 
 namespace noir::crypto {
 
@@ -22,4 +23,72 @@ struct Sha256 : public Hash<Sha256>, openssl::MessageDigest {
   auto digest_size() const -> size_t;
 };
 
+/// \brief calculates sha256 hash of input data into a fixed-size array, reusing a context of the current thread
+/// \param in input data
+/// \param out output array
+/// \ingroup crypto
+void sha256(std::span<const unsigned char> in, Bytes32& out);
+
+/// \brief calculates and returns sha256 hash of input data, reusing a context of the current thread
+/// \param in input data
+/// \return array containing hash
+/// \ingroup crypto
+auto sha256(std::span<const unsigned char> in) -> Bytes32;
+
+template<>
+void hash_many<Sha256>(std::span<const std::span<const unsigned char>> in, std::span<Bytes32> out);
+
+/// \brief generates sha256 hash keeping its state inline
+/// Computed with SHA-NI instructions when available, with portable code otherwise. Unlike Sha256, no OpenSSL context
+/// is allocated, which suits hashing many short messages such as merkle tree nodes.
+/// \ingroup crypto
+struct Sha256Native : public Hash<Sha256Native> {
+  using Hash::final;
+  using Hash::update;
+
+  Sha256Native() {
+    init();
+  }
+
+  auto init() -> Sha256Native&;
+  auto update(std::span<const unsigned char> in) -> Sha256Native&;
+  void final(std::span<unsigned char> out);
+
+  constexpr auto digest_size() const -> size_t {
+    return 32;
+  }
+
+  /// \brief computes hashes of two messages of the same length at once, interleaving their rounds
+  /// \param in0 first message
+  /// \param in1 second message; must have the same length as in0
+  /// \param out0 output buffer of 32 bytes for the hash of in0
+  /// \param out1 output buffer of 32 bytes for the hash of in1
+  static void hash2(std::span<const unsigned char> in0,
+    std::span<const unsigned char> in1,
+    std::span<unsigned char> out0,
+    std::span<unsigned char> out1);
+
+private:
+  std::array<uint32_t, 8> state{};
+  std::array<unsigned char, 64> buffer{};
+  size_t buffer_size{};
+  uint64_t total_size{};
+};
+
+/// \brief implementation of Sha256Native and hash_many<Sha256>
+/// \ingroup crypto
+enum class sha256_impl {
+  automatic, ///< fastest one supported by the CPU
+  portable, ///< plain C++, one message at a time
+  shani, ///< SHA-NI instructions, two messages at a time in hash_many
+  avx2, ///< AVX2 instructions, eight messages at a time in hash_many; portable code for a single message
+};
+
+/// \brief selects the implementation of Sha256Native and hash_many<Sha256> process-wide
+/// Meant for tests and benchmarks which need to exercise every implementation on the same CPU.
+/// \param impl implementation to use
+/// \return false if the CPU does not support impl, in which case the selection is unchanged
+/// \ingroup crypto
+bool set_sha256_impl(sha256_impl impl);
+
 } // namespace noir::crypto
@@ -0,0 +1,472 @@
+// This file is part of NOIR.
+//
+// Copyright (c) 2022 Haderech Pte. Ltd.
+// SPDX-License-Identifier: AGPL-3.0-or-later
+//
+#include <noir/common/check.h>
+#include <noir/crypto/hash/sha2.h>
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <cpuid.h>
+#include <immintrin.h>
+#define NOIR_SHA256_SHANI
+#endif
+
+namespace noir::crypto {
+
+namespace {
+
+  using state_type = std::array<uint32_t, 8>;
+
+  constexpr state_type initial_state = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+  alignas(16) constexpr uint32_t k[64] = {0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+    0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7,
+    0xc19bf174, 0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967, 0x27b70a85,
+    0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070, 0x19a4c116, 0x1e376c08, 0x2748774c,
+    0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+  uint32_t load_be32(const unsigned char* p) {
+    return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+  }
+
+  void store_be32(unsigned char* p, uint32_t v) {
+    p[0] = v >> 24;
+    p[1] = v >> 16;
+    p[2] = v >> 8;
+    p[3] = v;
+  }
+
+  void compress_portable(state_type& s, const unsigned char* blocks, size_t n) {
+    for (; n > 0; --n, blocks += 64) {
+      uint32_t w[64];
+      for (auto i = 0; i < 16; ++i)
+        w[i] = load_be32(blocks + 4 * i);
+      for (auto i = 16; i < 64; ++i) {
+        auto s0 = std::rotr(w[i - 15], 7) ^ std::rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        auto s1 = std::rotr(w[i - 2], 17) ^ std::rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+      }
+      auto [a, b, c, d, e, f, g, h] = s;
+      for (auto i = 0; i < 64; ++i) {
+        auto t1 = h + (std::rotr(e, 6) ^ std::rotr(e, 11) ^ std::rotr(e, 25)) + ((e & f) ^ (~e & g)) + k[i] + w[i];
+        auto t2 = (std::rotr(a, 2) ^ std::rotr(a, 13) ^ std::rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+      }
+      s[0] += a;
+      s[1] += b;
+      s[2] += c;
+      s[3] += d;
+      s[4] += e;
+      s[5] += f;
+      s[6] += g;
+      s[7] += h;
+    }
+  }
+
+#if defined(NOIR_SHA256_SHANI)
+#define NOIR_SHANI_TARGET __attribute__((target("sha,sse4.1,ssse3")))
+
+  // state as ABEF and CDGH words, the layout sha256rnds2 works on
+  struct shani_state {
+    __m128i abef;
+    __m128i cdgh;
+  };
+
+  NOIR_SHANI_TARGET shani_state load_state(const state_type& s) {
+    auto dcba = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&s[0])), 0xb1);
+    auto hgfe = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&s[4])), 0x1b);
+    return {_mm_alignr_epi8(dcba, hgfe, 8), _mm_blend_epi16(hgfe, dcba, 0xf0)};
+  }
+
+  NOIR_SHANI_TARGET void store_state(state_type& s, const shani_state& st) {
+    auto feba = _mm_shuffle_epi32(st.abef, 0x1b);
+    auto dchg = _mm_shuffle_epi32(st.cdgh, 0xb1);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&s[0]), _mm_blend_epi16(feba, dchg, 0xf0));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&s[4]), _mm_alignr_epi8(dchg, feba, 8));
+  }
+
+  NOIR_SHANI_TARGET __m128i load_message(const unsigned char* p) {
+    const auto mask = _mm_set_epi64x(0x0c0d0e0f08090a0bull, 0x0405060700010203ull);
+    return _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), mask);
+  }
+
+  // next 4 words of the message schedule from the previous 16
+  NOIR_SHANI_TARGET __m128i schedule(__m128i w0, __m128i w1, __m128i w2, __m128i w3) {
+    return _mm_sha256msg2_epu32(_mm_add_epi32(_mm_sha256msg1_epu32(w0, w1), _mm_alignr_epi8(w3, w2, 4)), w3);
+  }
+
+  // 4 rounds with message words w and constants k[4 * i, 4 * i + 4)
+  NOIR_SHANI_TARGET void rounds(shani_state& st, __m128i w, int i) {
+    auto wk = _mm_add_epi32(w, _mm_load_si128(reinterpret_cast<const __m128i*>(&k[4 * i])));
+    st.cdgh = _mm_sha256rnds2_epu32(st.cdgh, st.abef, wk);
+    std::swap(st.abef, st.cdgh);
+    st.cdgh = _mm_sha256rnds2_epu32(st.cdgh, st.abef, _mm_shuffle_epi32(wk, 0x0e));
+    std::swap(st.abef, st.cdgh);
+  }
+
+  NOIR_SHANI_TARGET void compress_block(shani_state& st, const unsigned char* block) {
+    auto saved = st;
+    __m128i w[4];
+#pragma GCC unroll 4
+    for (auto i = 0; i < 4; ++i) {
+      w[i] = load_message(block + 16 * i);
+      rounds(st, w[i], i);
+    }
+#pragma GCC unroll 12
+    for (auto i = 4; i < 16; ++i) {
+      w[i % 4] = schedule(w[i % 4], w[(i + 1) % 4], w[(i + 2) % 4], w[(i + 3) % 4]);
+      rounds(st, w[i % 4], i);
+    }
+    st.abef = _mm_add_epi32(st.abef, saved.abef);
+    st.cdgh = _mm_add_epi32(st.cdgh, saved.cdgh);
+  }
+
+  NOIR_SHANI_TARGET void compress_shani(state_type& s, const unsigned char* blocks, size_t n) {
+    auto st = load_state(s);
+    for (; n > 0; --n, blocks += 64)
+      compress_block(st, blocks);
+    store_state(s, st);
+  }
+
+  // the two block chains are independent, so their rounds are interleaved to hide the latency of sha256rnds2
+  NOIR_SHANI_TARGET void compress2_shani(
+    state_type& s0, state_type& s1, const unsigned char* blocks0, const unsigned char* blocks1, size_t n) {
+    auto st0 = load_state(s0);
+    auto st1 = load_state(s1);
+    for (; n > 0; --n, blocks0 += 64, blocks1 += 64) {
+      auto saved0 = st0;
+      auto saved1 = st1;
+      __m128i w0[4], w1[4];
+#pragma GCC unroll 4
+      for (auto i = 0; i < 4; ++i) {
+        w0[i] = load_message(blocks0 + 16 * i);
+        w1[i] = load_message(blocks1 + 16 * i);
+        rounds(st0, w0[i], i);
+        rounds(st1, w1[i], i);
+      }
+#pragma GCC unroll 12
+      for (auto i = 4; i < 16; ++i) {
+        w0[i % 4] = schedule(w0[i % 4], w0[(i + 1) % 4], w0[(i + 2) % 4], w0[(i + 3) % 4]);
+        w1[i % 4] = schedule(w1[i % 4], w1[(i + 1) % 4], w1[(i + 2) % 4], w1[(i + 3) % 4]);
+        rounds(st0, w0[i % 4], i);
+        rounds(st1, w1[i % 4], i);
+      }
+      st0.abef = _mm_add_epi32(st0.abef, saved0.abef);
+      st0.cdgh = _mm_add_epi32(st0.cdgh, saved0.cdgh);
+      st1.abef = _mm_add_epi32(st1.abef, saved1.abef);
+      st1.cdgh = _mm_add_epi32(st1.cdgh, saved1.cdgh);
+    }
+    store_state(s0, st0);
+    store_state(s1, st1);
+  }
+
+  bool has_hw_support() {
+    static const bool supported = []() {
+      unsigned int eax, ebx, ecx, edx;
+      if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || !(ecx & bit_SSE4_1) || !(ecx & bit_SSSE3))
+        return false;
+      return __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) && (ebx & bit_SHA);
+    }();
+    return supported;
+  }
+
+#define NOIR_AVX2_TARGET __attribute__((target("avx2")))
+
+  NOIR_AVX2_TARGET __m256i rotr8(__m256i x, int n) {
+    return _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - n));
+  }
+
+  NOIR_AVX2_TARGET __m256i add8(__m256i a, __m256i b) {
+    return _mm256_add_epi32(a, b);
+  }
+
+  // one block of each of 8 messages, word i of every state in the 32-bit lanes of s[i]
+  NOIR_AVX2_TARGET void compress8_avx2(__m256i (&s)[8], const unsigned char* const (&blocks)[8]) {
+    __m256i w[16];
+#pragma GCC unroll 16
+    for (auto i = 0; i < 16; ++i)
+      w[i] = _mm256_setr_epi32(load_be32(blocks[0] + 4 * i), load_be32(blocks[1] + 4 * i),
+        load_be32(blocks[2] + 4 * i), load_be32(blocks[3] + 4 * i), load_be32(blocks[4] + 4 * i),
+        load_be32(blocks[5] + 4 * i), load_be32(blocks[6] + 4 * i), load_be32(blocks[7] + 4 * i));
+    auto a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
+#pragma GCC unroll 64
+    for (auto i = 0; i < 64; ++i) {
+      if (i >= 16) {
+        auto w15 = w[(i + 1) % 16];
+        auto w2 = w[(i + 14) % 16];
+        auto s0 = _mm256_xor_si256(_mm256_xor_si256(rotr8(w15, 7), rotr8(w15, 18)), _mm256_srli_epi32(w15, 3));
+        auto s1 = _mm256_xor_si256(_mm256_xor_si256(rotr8(w2, 17), rotr8(w2, 19)), _mm256_srli_epi32(w2, 10));
+        w[i % 16] = add8(add8(w[i % 16], s0), add8(w[(i + 9) % 16], s1));
+      }
+      auto sum1 = _mm256_xor_si256(_mm256_xor_si256(rotr8(e, 6), rotr8(e, 11)), rotr8(e, 25));
+      auto ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+      auto t1 = add8(add8(add8(h, sum1), add8(ch, _mm256_set1_epi32(static_cast<int>(k[i])))), w[i % 16]);
+      auto sum0 = _mm256_xor_si256(_mm256_xor_si256(rotr8(a, 2), rotr8(a, 13)), rotr8(a, 22));
+      auto maj = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+      h = g;
+      g = f;
+      f = e;
+      e = add8(d, t1);
+      d = c;
+      c = b;
+      b = a;
+      a = add8(t1, add8(sum0, maj));
+    }
+    s[0] = add8(s[0], a);
+    s[1] = add8(s[1], b);
+    s[2] = add8(s[2], c);
+    s[3] = add8(s[3], d);
+    s[4] = add8(s[4], e);
+    s[5] = add8(s[5], f);
+    s[6] = add8(s[6], g);
+    s[7] = add8(s[7], h);
+  }
+
+  bool has_avx2() {
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+  }
+#endif
+
+  std::atomic<sha256_impl> selected_impl{sha256_impl::automatic};
+
+  bool use_shani() {
+#if defined(NOIR_SHA256_SHANI)
+    auto impl = selected_impl.load(std::memory_order_relaxed);
+    return (impl == sha256_impl::automatic || impl == sha256_impl::shani) && has_hw_support();
+#else
+    return false;
+#endif
+  }
+
+  bool use_avx2() {
+#if defined(NOIR_SHA256_SHANI)
+    auto impl = selected_impl.load(std::memory_order_relaxed);
+    return (impl == sha256_impl::automatic || impl == sha256_impl::avx2) && has_avx2();
+#else
+    return false;
+#endif
+  }
+
+  void compress(state_type& s, const unsigned char* blocks, size_t n) {
+#if defined(NOIR_SHA256_SHANI)
+    if (use_shani())
+      return compress_shani(s, blocks, n);
+#endif
+    compress_portable(s, blocks, n);
+  }
+
+  void compress2(state_type& s0, state_type& s1, const unsigned char* blocks0, const unsigned char* blocks1, size_t n) {
+#if defined(NOIR_SHA256_SHANI)
+    if (use_shani())
+      return compress2_shani(s0, s1, blocks0, blocks1, n);
+#endif
+    compress_portable(s0, blocks0, n);
+    compress_portable(s1, blocks1, n);
+  }
+
+  // pads the last `size % 64` bytes of a message of `size` bytes into one or two blocks; returns the number of blocks
+  size_t pad(const unsigned char* tail, size_t size, unsigned char (&blocks)[128]) {
+    auto rest = size % 64;
+    std::memset(blocks, 0, sizeof(blocks));
+    std::memcpy(blocks, tail, rest);
+    blocks[rest] = 0x80;
+    auto n = rest < 56 ? 1 : 2;
+    auto bits = uint64_t(size) * 8;
+    store_be32(blocks + 64 * n - 8, bits >> 32);
+    store_be32(blocks + 64 * n - 4, static_cast<uint32_t>(bits));
+    return n;
+  }
+
+  void store_digest(const state_type& s, unsigned char* out) {
+    for (auto i = 0; i < 8; ++i)
+      store_be32(out + 4 * i, s[i]);
+  }
+
+  // blocks of a message being hashed in a lane: full blocks read in place, then the padded tail
+  struct lane_blocks {
+    lane_blocks() = default;
+    lane_blocks(std::span<const unsigned char> in): data(in.data()), full(in.size() / 64) {
+      pad(data + full * 64, in.size(), tail);
+    }
+
+    const unsigned char* block(size_t i) const {
+      return i < full ? data + i * 64 : tail + (i - full) * 64;
+    }
+
+    const unsigned char* data{};
+    size_t full{};
+    unsigned char tail[128];
+  };
+
+  size_t block_count(size_t size) {
+    return (size + 8) / 64 + 1;
+  }
+
+  void hash_lanes2(std::span<const unsigned char> in0,
+    std::span<const unsigned char> in1,
+    unsigned char* out0,
+    unsigned char* out1) {
+    auto s0 = initial_state;
+    auto s1 = initial_state;
+    lane_blocks lane0(in0), lane1(in1);
+    for (size_t i = 0, n = block_count(in0.size()); i < n; ++i)
+      compress2(s0, s1, lane0.block(i), lane1.block(i), 1);
+    store_digest(s0, out0);
+    store_digest(s1, out1);
+  }
+
+#if defined(NOIR_SHA256_SHANI)
+  NOIR_AVX2_TARGET void hash_lanes8(
+    const std::span<const unsigned char>* const (&in)[8], unsigned char* const (&out)[8]) {
+    __m256i s[8];
+    for (auto i = 0; i < 8; ++i)
+      s[i] = _mm256_set1_epi32(static_cast<int>(initial_state[i]));
+    lane_blocks lanes[8];
+    for (auto l = 0; l < 8; ++l)
+      lanes[l] = lane_blocks(*in[l]);
+    for (size_t i = 0, n = block_count(in[0]->size()); i < n; ++i) {
+      const unsigned char* blocks[8];
+      for (auto l = 0; l < 8; ++l)
+        blocks[l] = lanes[l].block(i);
+      compress8_avx2(s, blocks);
+    }
+    alignas(32) uint32_t words[8][8];
+    for (auto i = 0; i < 8; ++i)
+      _mm256_store_si256(reinterpret_cast<__m256i*>(words[i]), s[i]);
+    for (auto l = 0; l < 8; ++l)
+      for (auto i = 0; i < 8; ++i)
+        store_be32(out[l] + 4 * i, words[i][l]);
+  }
+#endif
+
+} // namespace
+
+auto Sha256Native::init() -> Sha256Native& {
+  state = initial_state;
+  buffer_size = 0;
+  total_size = 0;
+  return *this;
+}
+
+auto Sha256Native::update(std::span<const unsigned char> in) -> Sha256Native& {
+  auto data = in.data();
+  auto size = in.size();
+  total_size += size;
+  if (buffer_size > 0) {
+    auto n = std::min(size, buffer.size() - buffer_size);
+    std::memcpy(buffer.data() + buffer_size, data, n);
+    buffer_size += n;
+    data += n;
+    size -= n;
+    if (buffer_size < buffer.size())
+      return *this;
+    compress(state, buffer.data(), 1);
+    buffer_size = 0;
+  }
+  if (size >= 64) {
+    compress(state, data, size / 64);
+    data += size / 64 * 64;
+    size %= 64;
+  }
+  std::memcpy(buffer.data(), data, size);
+  buffer_size = size;
+  return *this;
+}
+
+void Sha256Native::final(std::span<unsigned char> out) {
+  unsigned char blocks[128];
+  auto n = pad(buffer.data(), total_size, blocks);
+  compress(state, blocks, n);
+  store_digest(state, out.data());
+  init();
+}
+
+void Sha256Native::hash2(std::span<const unsigned char> in0,
+  std::span<const unsigned char> in1,
+  std::span<unsigned char> out0,
+  std::span<unsigned char> out1) {
+  check(in0.size() == in1.size(), "hash2 requires messages of the same length");
+  auto s0 = initial_state;
+  auto s1 = initial_state;
+  auto full = in0.size() / 64;
+  compress2(s0, s1, in0.data(), in1.data(), full);
+  unsigned char tail0[128], tail1[128];
+  auto n = pad(in0.data() + full * 64, in0.size(), tail0);
+  pad(in1.data() + full * 64, in1.size(), tail1);
+  compress2(s0, s1, tail0, tail1, n);
+  store_digest(s0, out0.data());
+  store_digest(s1, out1.data());
+}
+
+bool set_sha256_impl(sha256_impl impl) {
+#if defined(NOIR_SHA256_SHANI)
+  if ((impl == sha256_impl::shani && !has_hw_support()) || (impl == sha256_impl::avx2 && !has_avx2()))
+    return false;
+#else
+  if (impl == sha256_impl::shani || impl == sha256_impl::avx2)
+    return false;
+#endif
+  selected_impl.store(impl, std::memory_order_relaxed);
+  return true;
+}
+
+template<>
+void hash_many<Sha256>(std::span<const std::span<const unsigned char>> in, std::span<Bytes32> out) {
+  check(in.size() == out.size(), "hash_many requires an output for every message");
+  // two interleaved SHA-NI chains keep up with eight AVX2 lanes, which are several times faster than portable code
+  size_t lanes = 1;
+  if (use_shani())
+    lanes = 2;
+  else if (use_avx2())
+    lanes = 8;
+
+  // lanes advance block by block together, so messages of the same number of blocks are grouped
+  std::vector<size_t> blocks(in.size());
+  std::transform(in.begin(), in.end(), blocks.begin(), [](auto& m) { return block_count(m.size()); });
+  std::vector<size_t> order(in.size());
+  std::iota(order.begin(), order.end(), 0);
+  if (lanes > 1 && std::adjacent_find(blocks.begin(), blocks.end(), std::not_equal_to<>()) != blocks.end())
+    std::stable_sort(order.begin(), order.end(), [&](auto a, auto b) { return blocks[a] < blocks[b]; });
+
+  for (size_t i = 0; i < order.size();) {
+    auto end = i;
+    while (end < order.size() && blocks[order[end]] == blocks[order[i]])
+      ++end;
+#if defined(NOIR_SHA256_SHANI)
+    for (; lanes == 8 && end - i >= 8; i += 8) {
+      const std::span<const unsigned char>* lane_in[8];
+      unsigned char* lane_out[8];
+      for (auto l = 0; l < 8; ++l) {
+        lane_in[l] = &in[order[i + l]];
+        lane_out[l] = out[order[i + l]].data();
+      }
+      hash_lanes8(lane_in, lane_out);
+    }
+#endif
+    for (; lanes == 2 && end - i >= 2; i += 2)
+      hash_lanes2(in[order[i]], in[order[i + 1]], out[order[i]].data(), out[order[i + 1]].data());
+    for (; i < end; ++i)
+      Sha256Native().update(in[order[i]]).final(std::span(out[order[i]].data(), out[order[i]].size()));
+  }
+}
+
+} // namespace noir::crypto
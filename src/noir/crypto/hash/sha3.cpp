@@ -27,4 +27,17 @@ void Sha3_256::final(std::span<unsigned char> out) {
   Keccak_HashFinal(&*ctx, (BitSequence*)out.data());
 }
 
+void sha3_256(std::span<const unsigned char> in, Bytes32& out) {
+  Keccak_HashInstance ctx;
+  Keccak_HashInitialize_SHA3_256(&ctx);
+  Keccak_HashUpdate(&ctx, (BitSequence*)in.data(), in.size() * 8);
+  Keccak_HashFinal(&ctx, (BitSequence*)out.data());
+}
+
+auto sha3_256(std::span<const unsigned char> in) -> Bytes32 {
+  Bytes32 out;
+  sha3_256(in, out);
+  return out;
+}
+
 } // namespace noir::crypto
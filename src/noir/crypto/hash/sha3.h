@@ -31,4 +31,20 @@ private:
   std::optional<Keccak_HashInstance> ctx;
 };
 
+/// \brief calculates sha3-256 hash of input data into a fixed-size array, without heap allocation
+/// \param in input data
+/// \param out output array
+/// \ingroup crypto
+void sha3_256(std::span<const unsigned char> in, Bytes32& out);
+
+/// \brief calculates and returns sha3-256 hash of input data, without heap allocation
+/// \param in input data
+/// \return array containing hash
+/// \ingroup crypto
+auto sha3_256(std::span<const unsigned char> in) -> Bytes32;
+
+/// \note shares the Keccak-f lanes of hash_many<Keccak256>
+template<>
+void hash_many<Sha3_256>(std::span<const std::span<const unsigned char>> in, std::span<Bytes32> out);
+
 } // namespace noir::crypto
@@ -5,19 +5,63 @@
 //
 #include <noir/crypto/openssl/message_digest.h>
 
+#include <vector>
+
 namespace noir::openssl {
 
+namespace {
+  struct ContextPool {
+    static constexpr size_t max_size = 8;
+
+    ContextPool() {
+      contexts.reserve(max_size);
+    }
+    ~ContextPool();
+
+    std::vector<EVP_MD_CTX*> contexts;
+  };
+
+  thread_local ContextPool pool;
+  // digests living in other thread_local objects may be destroyed after the pool
+  thread_local bool pool_destroyed = false;
+
+  ContextPool::~ContextPool() {
+    for (auto ctx : contexts) {
+      EVP_MD_CTX_free(ctx);
+    }
+    pool_destroyed = true;
+  }
+
+  EVP_MD_CTX* acquire_context() {
+    if (pool_destroyed || pool.contexts.empty()) {
+      return EVP_MD_CTX_new();
+    }
+    auto ctx = pool.contexts.back();
+    pool.contexts.pop_back();
+    return ctx;
+  }
+
+  void release_context(EVP_MD_CTX* ctx) {
+    if (pool_destroyed || pool.contexts.size() >= ContextPool::max_size) {
+      EVP_MD_CTX_free(ctx);
+      return;
+    }
+    pool.contexts.push_back(ctx);
+  }
+} // namespace
+
 MessageDigest::~MessageDigest() {
   if (ctx) {
-    EVP_MD_CTX_free(ctx);
+    release_context(ctx);
   }
 }
 
 void MessageDigest::init(const EVP_MD* type) {
   if (!ctx) {
-    ctx = EVP_MD_CTX_new();
+    ctx = acquire_context();
   }
-  EVP_DigestInit(ctx, type);
+  // unlike EVP_DigestInit, keeps the state allocated by a previous use of the same digest
+  EVP_DigestInit_ex(ctx, type, nullptr);
 }
 
 void MessageDigest::update(std::span<const unsigned char> in) {
@@ -25,7 +69,7 @@ void MessageDigest::update(std::span<const unsigned char> in) {
 }
 
 void MessageDigest::final(std::span<unsigned char> out) {
-  EVP_DigestFinal(ctx, out.data(), nullptr);
+  EVP_DigestFinal_ex(ctx, out.data(), nullptr);
 }
 
 auto MessageDigest::digest_size(const EVP_MD* type) const -> size_t {
@@ -10,6 +10,8 @@
 namespace noir::openssl {
 
 /// \cond PRIVATE
+/// Contexts are taken from and returned to a pool of the current thread, and keep their digest implementation between
+/// uses, so that short-lived digests neither allocate a context nor look up the implementation again.
 struct MessageDigest {
   ~MessageDigest();
 
@@ -0,0 +1,80 @@
+// This file is part of NOIR.
+//
+// Copyright (c) 2022 Haderech Pte. Ltd.
+// SPDX-License-Identifier: AGPL-3.0-or-later
+//
+#include <catch2/catch_all.hpp>
+
+#include <noir/crypto/hash.h>
+#include <openssl/evp.h>
+
+using namespace noir;
+using namespace noir::crypto;
+
+namespace {
+
+// The former Sha256: a context allocated, and the digest looked up, for every temporary hasher
+Bytes allocating_sha256(std::span<const unsigned char> in) {
+  Bytes out(32);
+  auto ctx = EVP_MD_CTX_new();
+  EVP_DigestInit(ctx, EVP_sha256());
+  EVP_DigestUpdate(ctx, in.data(), in.size());
+  EVP_DigestFinal(ctx, out.data(), nullptr);
+  EVP_MD_CTX_free(ctx);
+  return out;
+}
+
+} // namespace
+
+TEST_CASE("HashBenchmarks", "[noir][crypto]") {
+  // size of a public key, as hashed by pub_key::address
+  auto key = Bytes(std::vector<unsigned char>(32, 1));
+  // size of a small transaction
+  auto tx = Bytes(std::vector<unsigned char>(256, 2));
+  Bytes32 out;
+  // a block of small transactions, hashed at once
+  std::vector<std::span<const unsigned char>> tx_spans(1000, tx);
+  std::vector<Bytes32> tx_hashes(tx_spans.size());
+  CHECK(allocating_sha256(key) == Sha256()(key));
+
+  BENCHMARK("AllocatingSha256Key") {
+    return allocating_sha256(key);
+  };
+  BENCHMARK("Sha256Key") {
+    return Sha256()(key);
+  };
+  BENCHMARK("OneShotSha256Key") {
+    sha256(key, out);
+    return out;
+  };
+  BENCHMARK("OneShotSha256Tx") {
+    sha256(tx, out);
+    return out;
+  };
+  BENCHMARK("Sha256ManyTxs") {
+    hash_many<Sha256>(tx_spans, tx_hashes);
+    return tx_hashes[0];
+  };
+  BENCHMARK("Sha3_256Tx") {
+    return Sha3_256()(tx);
+  };
+  BENCHMARK("OneShotSha3_256Tx") {
+    sha3_256(tx, out);
+    return out;
+  };
+  BENCHMARK("Sha3_256ManyTxs") {
+    hash_many<Sha3_256>(tx_spans, tx_hashes);
+    return tx_hashes[0];
+  };
+  BENCHMARK("Keccak256Tx") {
+    return Keccak256()(tx);
+  };
+  BENCHMARK("OneShotKeccak256Tx") {
+    keccak256(tx, out);
+    return out;
+  };
+  BENCHMARK("Keccak256ManyTxs") {
+    hash_many<Keccak256>(tx_spans, tx_hashes);
+    return tx_hashes[0];
+  };
+}
@@ -18,6 +18,7 @@ TEST_CASE("hash: keccak256", "[noir][crypto]") {
   });
 
   std::for_each(tests.begin(), tests.end(), [&](auto& t) { CHECK(Keccak256()(t.first) == t.second); });
+  std::for_each(tests.begin(), tests.end(), [&](auto& t) { CHECK(Bytes(keccak256(bytes_view(t.first))) == t.second); });
 
   {
     auto hash = Keccak256();
@@ -37,6 +38,7 @@ TEST_CASE("hash: sha256", "[noir][crypto]") {
   });
 
   std::for_each(tests.begin(), tests.end(), [&](auto& t) { CHECK(Sha256()(t.first) == t.second); });
+  std::for_each(tests.begin(), tests.end(), [&](auto& t) { CHECK(Bytes(sha256(bytes_view(t.first))) == t.second); });
 
   {
     auto hash = Sha256();
@@ -48,6 +50,104 @@ TEST_CASE("hash: sha256", "[noir][crypto]") {
   }
 }
 
+TEST_CASE("hash: sha256 with reused contexts", "[noir][crypto]") {
+  auto data0 = std::string(100, 'x');
+  auto data1 = std::string(100, 'y');
+  auto expected0 = Sha256()(data0);
+  auto expected1 = Sha256()(data1);
+
+  // contexts released by destroyed hashers are handed to the next ones, possibly in the middle of a hash
+  for (auto i = 0; i < 20; i++) {
+    auto hash0 = Sha256();
+    hash0.update(std::string_view(data0).substr(0, 50));
+    {
+      auto hash1 = Sha256();
+      hash1.update(data1);
+      CHECK(Bytes(sha256(bytes_view(data0))) == expected0);
+      CHECK(hash1.final() == expected1);
+    }
+    hash0.update(std::string_view(data0).substr(50));
+    CHECK(hash0.final() == expected0);
+  }
+}
+
+TEST_CASE("hash: sha256_native", "[noir][crypto]") {
+  auto tests = std::to_array<std::pair<std::string, Bytes>>({
+    {"", {"e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"}},
+    {"The quick brown fox jumps over the lazy dog",
+      {"d7a8fbb307d7809469ca9abcb0082e4f8d5651e46d3cdb762d02d0bf37c9e592"}},
+  });
+
+  std::for_each(tests.begin(), tests.end(), [&](auto& t) { CHECK(Sha256Native()(t.first) == t.second); });
+
+  // every padding case, with incremental updates and two messages at once
+  for (size_t size = 0; size < 200; size++) {
+    auto data0 = std::string(size, 'x');
+    auto data1 = std::string(size, 'y');
+    auto hash = Sha256Native();
+    for (size_t i = 0; i < data0.size(); i += 7)
+      hash.update(std::string_view(data0).substr(i, 7));
+    CHECK(hash.final() == Sha256()(data0));
+
+    Bytes out0(32), out1(32);
+    Sha256Native::hash2(bytes_view(data0), bytes_view(data1), out0, out1);
+    CHECK(out0 == Sha256()(data0));
+    CHECK(out1 == Sha256()(data1));
+  }
+}
+
+TEST_CASE("hash: hash_many", "[noir][crypto]") {
+  // messages of every padding case in shuffled order, so that lanes are filled by messages of equal block counts
+  std::vector<std::string> messages;
+  for (size_t i = 0; i < 600; i++)
+    messages.push_back(std::string((i * 37) % 300, static_cast<char>(i)));
+  std::vector<std::span<const unsigned char>> in;
+  for (auto& m : messages)
+    in.push_back(bytes_view(m));
+
+  std::vector<Bytes32> out(in.size());
+  hash_many<Sha256>(in, out);
+  for (size_t i = 0; i < in.size(); i++)
+    CHECK(out[i] == sha256(in[i]));
+  hash_many<Keccak256>(in, out);
+  for (size_t i = 0; i < in.size(); i++)
+    CHECK(out[i] == keccak256(in[i]));
+  hash_many<Sha3_256>(in, out);
+  for (size_t i = 0; i < in.size(); i++)
+    CHECK(out[i] == sha3_256(in[i]));
+}
+
+TEST_CASE("hash: sha256 implementations", "[noir][crypto]") {
+  std::vector<std::string> messages;
+  for (size_t i = 0; i < 200; i++)
+    messages.push_back(std::string((i * 37) % 300, static_cast<char>(i)));
+  std::vector<std::span<const unsigned char>> in;
+  for (auto& m : messages)
+    in.push_back(bytes_view(m));
+
+  for (auto impl : {sha256_impl::portable, sha256_impl::shani, sha256_impl::avx2}) {
+    if (!set_sha256_impl(impl)) {
+      WARN("sha256 implementation " << static_cast<int>(impl) << " is not supported by this CPU");
+      continue;
+    }
+    INFO("sha256 implementation " << static_cast<int>(impl));
+    std::vector<Bytes32> out(in.size());
+    hash_many<Sha256>(in, out);
+    for (size_t i = 0; i < in.size(); i++) {
+      CHECK(out[i] == sha256(in[i]));
+      CHECK(Sha256Native()(in[i]) == Sha256()(in[i]));
+    }
+    for (size_t i = 0; i < in.size(); i++) {
+      auto other = std::string(in[i].size(), 'z');
+      Bytes out0(32), out1(32);
+      Sha256Native::hash2(in[i], bytes_view(other), out0, out1);
+      CHECK(out0 == Sha256()(in[i]));
+      CHECK(out1 == Sha256()(other));
+    }
+  }
+  CHECK(set_sha256_impl(sha256_impl::automatic));
+}
+
 TEST_CASE("hash: blake2b_256", "[noir][crypto]") {
   auto tests = std::to_array<std::pair<std::string, Bytes>>({
     {"", {"0e5751c026e543b2e8ab2eb06099daa1d1e5df47778f7787faab45cdf12fe3a8"}},
@@ -93,6 +193,7 @@ TEST_CASE("hash: sha3_256", "[noir][crypto]") {
   });
 
   std::for_each(tests.begin(), tests.end(), [&](auto& t) { CHECK(Sha3_256()(t.first) == t.second); });
+  std::for_each(tests.begin(), tests.end(), [&](auto& t) { CHECK(Bytes(sha3_256(bytes_view(t.first))) == t.second); });
 
   {
     auto hash = Sha3_256();
@@ -121,3 +222,49 @@ TEST_CASE("hash: xxhash", "[noir][crypto]") {
     }
   }
 }
+
+TEST_CASE("hash: crc32c", "[noir][crypto]") {
+  auto tests = std::to_array<std::pair<std::string, uint32_t>>({
+    {"", 0x00000000},
+    {"123456789", 0xe3069283},
+    {"The quick brown fox jumps over the lazy dog", 0x22620404},
+  });
+
+  std::for_each(tests.begin(), tests.end(), [&](auto& t) { CHECK(Crc32c()(t.first) == t.second); });
+
+  {
+    auto hash = Crc32c();
+    for (const auto& test : tests) {
+      hash.update(test.first);
+      CHECK(hash.final() == test.second);
+      hash.init();
+    }
+  }
+
+  {
+    // incremental updates with unaligned chunks must match the one-shot checksum
+    auto data = std::string(1000, 'x');
+    auto hash = Crc32c();
+    for (size_t i = 0; i < data.size(); i += 7) {
+      hash.update(std::string_view(data).substr(i, 7));
+    }
+    CHECK(hash.final() == Crc32c()(data));
+  }
+
+  {
+    // table-driven fallback, which Crc32c does not use on CPUs with CRC32 instructions
+    std::for_each(tests.begin(), tests.end(),
+      [&](auto& t) { CHECK(~crypto::detail::crc32c_portable(0xffffffff, bytes_view(t.first)) == t.second); });
+
+    std::string data;
+    for (size_t i = 0; i < 1000; i++)
+      data.push_back(static_cast<char>(i * 31));
+    for (size_t size = 0; size < data.size(); size += 37) {
+      auto view = std::string_view(data).substr(0, size);
+      auto head = view.substr(0, size / 3), tail = view.substr(size / 3);
+      auto crc = crypto::detail::crc32c_portable(0xffffffff, bytes_view(head));
+      crc = crypto::detail::crc32c_portable(crc, bytes_view(tail));
+      CHECK(~crc == Crc32c()(view));
+    }
+  }
+}
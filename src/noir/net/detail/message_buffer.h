@@ -10,6 +10,7 @@
 #include <boost/asio/buffer.hpp>
 #include <boost/pool/singleton_pool.hpp>
 #include <fmt/core.h>
+#include <algorithm>
 #include <array>
 #include <deque>
 #include <utility>
@@ -138,6 +139,14 @@ public:
     return bytes_to_read_from_index(read_ind);
   }
 
+  /*
+   *  Returns the number of bytes that can be read from the read pointer
+   *  without crossing into the next buffer of the chain.
+   */
+  uint32_t contiguous_bytes_to_read() const {
+    return std::min(bytes_to_read(), buffer_len - read_ind.second);
+  }
+
   /*
    *  Returns the current number of bytes remaining to be read from a given index
    *  Logically, this is the different between where the given index is and the write pointers.
@@ -256,6 +265,20 @@ public:
     return success();
   }
 
+  /*
+   *  Returns a pointer to the next size bytes to be read. If they are split
+   *  between two buffers of the chain, they are copied into scratch first,
+   *  which must hold at least size bytes. The read pointer is unaffected.
+   */
+  char* contiguous_read_ptr(void* scratch, uint32_t size) {
+    if (contiguous_bytes_to_read() >= size)
+      return read_ptr();
+    auto index = read_ind;
+    if (!peek(scratch, size, index))
+      return nullptr;
+    return static_cast<char*>(scratch);
+  }
+
   /*
    *  Advances the supplied index along the buffer chain the specified
    *  number of bytes.
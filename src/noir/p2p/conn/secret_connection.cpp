@@ -125,65 +125,95 @@ Bytes secret_connection::derive_secrets(Bytes32& dh_secret) {
   return {key, key + sizeof(key) / sizeof(key[0])};
 }
 
-Result<std::pair<int, std::vector<std::shared_ptr<Bytes>>>> secret_connection::write(std::span<unsigned char> data) {
+std::shared_ptr<std::vector<unsigned char>> sealed_buffer_pool::acquire(size_t size) {
+  std::unique_ptr<std::vector<unsigned char>> buffer;
+  {
+    std::scoped_lock g(mtx);
+    if (!buffers.empty()) {
+      buffer = std::move(buffers.back());
+      buffers.pop_back();
+    }
+  }
+  if (!buffer)
+    buffer = std::make_unique<std::vector<unsigned char>>();
+  buffer->resize(size);
+  return {buffer.release(), [pool = weak_from_this()](std::vector<unsigned char>* buffer) {
+            if (auto p = pool.lock())
+              p->release(buffer);
+            else
+              delete buffer;
+          }};
+}
+
+void sealed_buffer_pool::release(std::vector<unsigned char>* buffer) {
+  std::unique_ptr<std::vector<unsigned char>> owned(buffer);
+  if (owned->capacity() > max_capacity)
+    return;
+  std::scoped_lock g(mtx);
+  if (buffers.size() < max_buffers)
+    buffers.push_back(std::move(owned));
+}
+
+size_t secret_connection::sealed_size(size_t data_size) {
+  return (data_size + data_max_size - 1) / data_max_size * sealed_frame_size;
+}
+
+Result<std::pair<int, std::shared_ptr<std::vector<unsigned char>>>> secret_connection::write(
+  std::span<const std::span<const unsigned char>> data) {
+  size_t data_size{};
+  for (const auto& d : data)
+    data_size += d.size();
+  auto sealed = buffer_pool->acquire(sealed_size(data_size));
+
   std::scoped_lock g(send_mtx);
-  int n{};
-  std::vector<std::shared_ptr<Bytes>> ret;
-  auto data_pos = data.begin();
-  while (data_pos != data.end()) {
-    auto sealed_frame = std::make_shared<Bytes>(sealed_frame_size);
-    Bytes frame(total_frame_size);
-    Bytes chunk;
-    auto data_size = std::distance(data_pos, data.end());
-    if (data_max_size < data_size) {
-      auto split_pos = data_pos + data_max_size;
-      chunk.raw().resize(data_max_size);
-      std::copy(data_pos, split_pos, chunk.data());
-      data_pos = split_pos; // TODO : check
-    } else {
-      chunk.raw().resize(data_size);
-      std::copy(data_pos, data.end(), chunk.data());
-      data_pos = data.end();
+  auto part = data.begin();
+  size_t part_pos{};
+  for (size_t offset = 0; offset < sealed->size(); offset += sealed_frame_size) {
+    auto frame = sealed->data() + offset;
+    // gather the chunk of this frame right after its length, then encrypt the frame over itself
+    uint32_t chunk_length{};
+    while (chunk_length < data_max_size && part != data.end()) {
+      auto n = std::min<size_t>(data_max_size - chunk_length, part->size() - part_pos);
+      std::memcpy(frame + data_len_size + chunk_length, part->data() + part_pos, n);
+      chunk_length += n;
+      part_pos += n;
+      if (part_pos == part->size()) {
+        ++part;
+        part_pos = 0;
+      }
     }
-    auto chunk_length = chunk.size();
-    const uint32_t payload_size = chunk_length;
-    const char* const header = reinterpret_cast<const char* const>(&payload_size);
-    std::memcpy(frame.data(), header, 4);
-    std::memcpy(frame.data() + 4, chunk.data(), chunk.size());
+    std::memcpy(frame, &chunk_length, data_len_size);
+    std::memset(frame + data_len_size + chunk_length, 0, data_max_size - chunk_length);
 
-    // Encrypt frame
     unsigned long long ciphertext_len{};
-    crypto_aead_chacha20poly1305_ietf_encrypt(sealed_frame->data(), &ciphertext_len,
-      reinterpret_cast<const unsigned char*>(frame.data()), frame.size(), nullptr, 0, nullptr, send_nonce.get(),
-      reinterpret_cast<const unsigned char*>(send_secret.data()));
+    crypto_aead_chacha20poly1305_ietf_encrypt(frame, &ciphertext_len, frame, total_frame_size, nullptr, 0, nullptr,
+      send_nonce.get(), reinterpret_cast<const unsigned char*>(send_secret.data()));
     send_nonce.increment();
-
-    n += chunk_length;
-    ret.push_back(sealed_frame);
   }
-  return {n, ret};
+  return {static_cast<int>(data_size), sealed};
+}
+
+Result<std::pair<int, std::shared_ptr<std::vector<unsigned char>>>> secret_connection::write(
+  std::span<const unsigned char> data) {
+  return write(std::span(&data, 1));
 }
 
-Result<std::shared_ptr<Bytes>> secret_connection::read(std::span<unsigned char> data, bool is_peek) {
+Result<std::span<const unsigned char>> secret_connection::read(std::span<unsigned char> sealed_frame) {
   std::scoped_lock g(recv_mtx);
-  check(data.size() == 1044, "invalid sealed_frame size");
+  check(sealed_frame.size() == sealed_frame_size, "invalid sealed_frame size");
 
-  Bytes frame(total_frame_size);
-  unsigned long long decrypted_len{}, ciphertext_len{data.size()};
-  auto r = crypto_aead_chacha20poly1305_ietf_decrypt(frame.data(), &decrypted_len, nullptr, data.data(), ciphertext_len,
-    nullptr, 0, recv_nonce.get(), reinterpret_cast<const unsigned char*>(recv_secret.data()));
+  unsigned long long decrypted_len{};
+  auto r = crypto_aead_chacha20poly1305_ietf_decrypt(sealed_frame.data(), &decrypted_len, nullptr, sealed_frame.data(),
+    sealed_frame.size(), nullptr, 0, recv_nonce.get(), reinterpret_cast<const unsigned char*>(recv_secret.data()));
   if (r < 0)
-    return Error::format("decryption failed: size={}", data.size());
-  if (!is_peek)
-    recv_nonce.increment();
+    return Error::format("decryption failed: size={}", sealed_frame.size());
+  recv_nonce.increment();
 
   uint32_t chunk_length;
-  std::memcpy(&chunk_length, frame.data(), data_len_size);
+  std::memcpy(&chunk_length, sealed_frame.data(), data_len_size);
   if (chunk_length > data_max_size)
     return Error::format("chunk_length is greater than data_max_size");
-  auto chunk = std::make_shared<Bytes>(chunk_length);
-  std::memcpy(chunk->data(), frame.data() + data_len_size, chunk_length);
-  return chunk;
+  return sealed_frame.subspan(data_len_size, chunk_length);
 }
 
 } // namespace noir::p2p
@@ -8,6 +8,7 @@
 #include <noir/p2p/types.h>
 #include <mutex>
 #include <optional>
+#include <vector>
 
 namespace noir::p2p {
 
@@ -56,6 +57,21 @@ struct auth_sig_message {
   Bytes sig;
 };
 
+/// \brief recycles buffers of sealed frames once they are written to the socket
+struct sealed_buffer_pool : std::enable_shared_from_this<sealed_buffer_pool> {
+  static constexpr size_t max_buffers = 16;
+  static constexpr size_t max_capacity = 1024 * 1024;
+
+  /// \brief returns a buffer of given size, given back to the pool when its last reference is released
+  std::shared_ptr<std::vector<unsigned char>> acquire(size_t size);
+
+private:
+  void release(std::vector<unsigned char>* buffer);
+
+  std::mutex mtx;
+  std::vector<std::unique_ptr<std::vector<unsigned char>>> buffers;
+};
+
 struct secret_connection {
   Bytes loc_priv_key;
   Bytes loc_pub_key;
@@ -78,6 +94,8 @@ struct secret_connection {
 
   bool is_authorized{};
 
+  std::shared_ptr<sealed_buffer_pool> buffer_pool = std::make_shared<sealed_buffer_pool>();
+
   static std::shared_ptr<secret_connection> make_secret_connection(Bytes& loc_priv_key);
 
   std::optional<std::string> shared_eph_pub_key(Bytes32& received_pub_key);
@@ -86,8 +104,20 @@ struct secret_connection {
 
   Bytes derive_secrets(Bytes32& dh_secret);
 
-  Result<std::pair<int, std::vector<std::shared_ptr<Bytes>>>> write(std::span<unsigned char> data);
-  Result<std::shared_ptr<Bytes>> read(std::span<unsigned char> data, bool is_peek = false);
+  /// \brief returns the size of sealed frames carrying data of given size
+  static size_t sealed_size(size_t data_size);
+
+  /// \brief splits data into frames and seals them in place into one pooled buffer, to be written at once
+  /// \param data plaintext, gathered from consecutive buffers
+  /// \return number of plaintext bytes and the sealed frames
+  Result<std::pair<int, std::shared_ptr<std::vector<unsigned char>>>> write(
+    std::span<const std::span<const unsigned char>> data);
+  Result<std::pair<int, std::shared_ptr<std::vector<unsigned char>>>> write(std::span<const unsigned char> data);
+
+  /// \brief opens a sealed frame in place
+  /// \param sealed_frame frame of sealed_frame_size bytes, overwritten with its plaintext
+  /// \return chunk carried by the frame, pointing into sealed_frame
+  Result<std::span<const unsigned char>> read(std::span<unsigned char> sealed_frame);
 };
 
 } // namespace noir::p2p
@@ -6,6 +6,7 @@
 #include <catch2/catch_all.hpp>
 #include <noir/common/hex.h>
 #include <noir/common/types.h>
+#include <noir/net/detail/message_buffer.h>
 #include <noir/p2p/conn/merlin.h>
 #include <noir/p2p/conn/secret_connection.h>
 
@@ -273,13 +274,14 @@ TEST_CASE("secret_connection: write and read", "[noir][p2p]") {
   SECTION("simple") {
     Bytes bz("abcd");
     auto w_ok = c->write(bz);
-    auto w_buff = *w_ok.value().second[0];
+    auto w_buff = *w_ok.value().second;
+    CHECK(w_buff.size() == p2p::sealed_frame_size);
     // std::cout << to_hex(w_buff) << std::endl;
 
     auto r_ok = c->read(w_buff);
-    auto r_buff = r_ok.value();
+    auto r_buff = Bytes(r_ok.value());
     // std::cout << to_hex(r_buff) << std::endl;
-    CHECK(*r_buff == bz);
+    CHECK(r_buff == bz);
   }
 
   SECTION("big") {
@@ -288,11 +290,11 @@ TEST_CASE("secret_connection: write and read", "[noir][p2p]") {
     Bytes bz(1000);
     std::memcpy(bz.data(), buff, sizeof(buff));
     auto w_ok = c->write(bz);
-    auto w_buff = *w_ok.value().second[0];
+    auto w_buff = *w_ok.value().second;
 
     auto r_ok = c->read(w_buff);
-    auto r_buff = r_ok.value();
-    CHECK(*r_buff == bz);
+    auto r_buff = Bytes(r_ok.value());
+    CHECK(r_buff == bz);
   }
 
   SECTION("bigger") {
@@ -302,18 +304,81 @@ TEST_CASE("secret_connection: write and read", "[noir][p2p]") {
     Bytes bz(data_len);
     std::memcpy(bz.data(), buff, sizeof(buff));
     auto w_ok = c->write(bz);
-    auto w_buffs = w_ok.value().second;
+    auto sealed = w_ok.value().second;
+    auto& w_buff = *sealed;
+    CHECK(w_buff.size() == 3 * p2p::sealed_frame_size);
     Bytes restored(data_len);
     int i{};
-    for (auto& b : w_buffs) {
-      auto r_ok = c->read(*b);
+    for (size_t offset = 0; offset < w_buff.size(); offset += p2p::sealed_frame_size) {
+      auto r_ok = c->read({w_buff.data() + offset, p2p::sealed_frame_size});
       auto r_buff = r_ok.value();
-      std::copy(r_buff->begin(), r_buff->end(), restored.begin() + i);
-      i += r_buff->size();
+      std::copy(r_buff.begin(), r_buff.end(), restored.begin() + i);
+      i += r_buff.size();
       // std::cout << i << " " << r_ok->first <<std::endl;
     }
     CHECK(restored == bz);
   }
+
+  SECTION("gathered") {
+    Bytes header("0102");
+    Bytes bz(2000);
+    randombytes_buf(bz.data(), bz.size());
+    std::span<const unsigned char> parts[] = {header, bz};
+    auto w_ok = c->write(parts);
+    CHECK(w_ok.value().first == 2002);
+    auto sealed = w_ok.value().second;
+    auto& w_buff = *sealed;
+    CHECK(w_buff.size() == 2 * p2p::sealed_frame_size);
+
+    Bytes restored;
+    for (size_t offset = 0; offset < w_buff.size(); offset += p2p::sealed_frame_size) {
+      auto chunk = c->read({w_buff.data() + offset, p2p::sealed_frame_size}).value();
+      restored.raw().insert(restored.end(), chunk.begin(), chunk.end());
+    }
+    CHECK(Bytes(restored.begin(), restored.begin() + 2) == header);
+    CHECK(Bytes(restored.begin() + 2, restored.end()) == bz);
+  }
+}
+
+TEST_CASE("secret_connection: read frames from a message buffer", "[noir][p2p]") {
+  auto priv_key_str =
+    base64::decode("q4BNZ9LFQw60L4UzkwkmRB2x2IPJGKwUaFXzbDTAXD5RezWnXQynrSHrYj602Dt6u6ga7T5Uc1pienw7b5JAbQ==");
+  Bytes loc_priv_key(priv_key_str.begin(), priv_key_str.end());
+  auto c = p2p::secret_connection::make_secret_connection(loc_priv_key);
+  c->send_secret = Bytes32{"9fe4a5a73df12dbd8659b1d9280873fe993caefec6b0ebc2686dd65027148e03"};
+  c->recv_secret = Bytes32{"9fe4a5a73df12dbd8659b1d9280873fe993caefec6b0ebc2686dd65027148e03"};
+
+  // buffer length is not a multiple of the frame size, so some frames straddle two buffers of the chain
+  static constexpr uint32_t buffer_len = 2048;
+  static_assert(buffer_len % p2p::sealed_frame_size != 0);
+  net::detail::message_buffer<buffer_len> mb;
+
+  Bytes bz(5000);
+  randombytes_buf(bz.data(), bz.size());
+  auto sealed = c->write(bz).value().second;
+  CHECK(sealed->size() == 5 * p2p::sealed_frame_size);
+  mb.add_space(sealed->size());
+  auto written = boost::asio::buffer_copy(
+    mb.get_buffer_sequence_for_boost_async_read().value(), boost::asio::buffer(*sealed));
+  CHECK(written == sealed->size());
+  mb.advance_write_ptr(written);
+
+  Bytes restored;
+  int straddling{};
+  while (mb.bytes_to_read() >= p2p::sealed_frame_size) {
+    std::array<unsigned char, p2p::sealed_frame_size> split_frame;
+    if (mb.contiguous_bytes_to_read() < p2p::sealed_frame_size)
+      ++straddling;
+    auto* frame_ptr = mb.contiguous_read_ptr(split_frame.data(), p2p::sealed_frame_size);
+    REQUIRE(frame_ptr != nullptr);
+    auto chunk = c->read({reinterpret_cast<unsigned char*>(frame_ptr), p2p::sealed_frame_size});
+    REQUIRE(chunk);
+    restored.raw().insert(restored.end(), chunk.value().begin(), chunk.value().end());
+    mb.advance_read_ptr(p2p::sealed_frame_size);
+  }
+  CHECK(mb.bytes_to_read() == 0);
+  CHECK(straddling == 2);
+  CHECK(restored == bz);
 }
 
 Result<Bytes> sign_ed25519(const Bytes& msg, const Bytes& key) {
@@ -1080,15 +1080,19 @@ void connection::read_a_secret_message() {
                   conn->outstanding_read_bytes = sealed_frame_size - bytes_in_buffer;
                   break;
                 } else {
-                  if (auto ok = conn->secret_conn->read(std::span<unsigned char>(
-                        reinterpret_cast<unsigned char*>(conn->pending_message_buffer.read_ptr()), sealed_frame_size));
-                      (!ok)) {
+                  // open the frame in place, unless it is split between two buffers of the ring
+                  std::array<unsigned char, sealed_frame_size> split_frame;
+                  auto* frame_ptr =
+                    conn->pending_message_buffer.contiguous_read_ptr(split_frame.data(), sealed_frame_size);
+                  std::span<unsigned char> sealed_frame(
+                    reinterpret_cast<unsigned char*>(frame_ptr), sealed_frame_size);
+                  if (auto ok = conn->secret_conn->read(sealed_frame); (!ok)) {
                     elog("getting pending frame failed");
                     throw;
                   } else {
-                    auto frame = ok.value();
-                    std::copy(frame->begin(), frame->end(), conn->decrypted_message_buffer.write_ptr());
-                    conn->decrypted_message_buffer.advance_write_ptr(frame->size());
+                    auto chunk = ok.value();
+                    std::copy(chunk.begin(), chunk.end(), conn->decrypted_message_buffer.write_ptr());
+                    conn->decrypted_message_buffer.advance_write_ptr(chunk.size());
                   }
                   conn->pending_message_buffer.advance_read_ptr(sealed_frame_size);
                   conn->latest_msg_time = get_time();
@@ -1157,26 +1161,24 @@ Result<int> connection::write_msg(const Bytes& bz, bool use_secret_conn) {
   std::array<unsigned char, 10> t_buffer{};
   datastream<unsigned char> t_ds(t_buffer);
   auto header_size = write_uleb128(t_ds, payload_size);
-  const size_t buffer_size = header_size + payload_size;
-  auto send_buffer = std::make_shared<std::vector<unsigned char>>(buffer_size);
-
-  datastream<unsigned char> ds(send_buffer->data(), buffer_size);
-  write_uleb128(ds, payload_size);
-  ds.write(bz.data(), payload_size);
 
   if (use_secret_conn) {
-    // must use encrypted channel
-    auto ok = secret_conn->write(std::span<unsigned char>(send_buffer->data(), send_buffer->size()));
+    // must use encrypted channel; frames are sealed straight from the header and payload into one buffer
+    std::span<const unsigned char> parts[] = {{t_buffer.data(), header_size}, {bz.data(), bz.size()}};
+    auto ok = secret_conn->write(parts);
     if (!ok)
       return Error::format("failed to convert message to encrypted ones");
-    for (auto& msg : ok.value().second) {
-      auto temp_buff = std::make_shared<std::vector<unsigned char>>(msg->size());
-      std::memcpy(temp_buff->data(), msg->data(), msg->size());
-      enqueue_buffer(temp_buff, close_after_send);
-    }
+    enqueue_buffer(ok.value().second, close_after_send);
     return ok.value().first;
   }
 
+  const size_t buffer_size = header_size + payload_size;
+  auto send_buffer = std::make_shared<std::vector<unsigned char>>(buffer_size);
+
+  datastream<unsigned char> ds(send_buffer->data(), buffer_size);
+  write_uleb128(ds, payload_size);
+  ds.write(bz.data(), payload_size);
+
   enqueue_buffer(send_buffer, close_after_send);
   return send_buffer->size();
 }
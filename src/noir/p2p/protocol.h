@@ -226,6 +226,8 @@ using internal_message = std::variant<proposal_message, block_part_message, vote
 struct internal_msg_info {
   internal_message msg;
   std::string peer_id; // TODO: not sure if peer_id field is required
+  // part set root consensus_reactor checked the proof of a block part against; not written to the WAL
+  Bytes verified_part_root{};
 };
 using internal_msg_info_ptr = std::shared_ptr<internal_msg_info>;
 
@@ -242,5 +244,6 @@ NOIR_REFLECT(noir::p2p::block_part_message, height, round, index, bytes_, proof)
 NOIR_REFLECT(noir::p2p::vote_message, type, height, round, block_id_, timestamp, validator_address, validator_index,
   signature);
 NOIR_REFLECT(noir::p2p::has_vote_message, height, round, type, index);
+NOIR_REFLECT(noir::p2p::internal_msg_info, msg, peer_id);
 NOIR_REFLECT(noir::p2p::vote_set_maj23_message, height, round, type, block_id_);
 NOIR_REFLECT(noir::p2p::vote_set_bits_message, height, round, type, block_id_, votes);
@@ -3,6 +3,7 @@
 // Copyright (c) 2022 Haderech Pte. Ltd.
 // SPDX-License-Identifier: AGPL-3.0-or-later
 //
+#include <noir/consensus/abci.h>
 #include <noir/rpc/jsonrpc.h>
 #include <noir/tendermint/rpc/rpc.h>
 #include <fc/crypto/base64.hpp>
@@ -79,6 +80,18 @@ void rpc::plugin_startup() {
     to_variant(result, res);
     return res;
   });
+  endpoint.add_handler("consensus_metrics", [&](auto& req) {
+    auto abci_ptr = app.find_plugin<consensus::abci>();
+    check(abci_ptr && abci_ptr->node_ && abci_ptr->node_->cs_reactor, "consensus is not running");
+    auto result = abci_ptr->node_->cs_reactor->cs_state->metrics.summarize();
+    variants res;
+    for (const auto& summary : result) {
+      variant v;
+      to_variant(summary, v);
+      res.push_back(v);
+    }
+    return fc::variant(res);
+  });
 }
 
 void rpc::plugin_shutdown() {}
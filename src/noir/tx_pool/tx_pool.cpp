@@ -214,8 +214,9 @@ void tx_pool::update(uint64_t block_height,
   }
 
   size_t size = std::min(block_txs.size(), responses.size());
+  auto tx_hashes = consensus::get_tx_hashes({block_txs.data(), size});
   for (auto i = 0; i < size; i++) {
-    auto tx_hash = consensus::get_tx_hash(*block_txs[i]);
+    auto& tx_hash = tx_hashes[i];
     if (responses[i].code == consensus::code_type_ok) {
       tx_cache_.put(tx_hash, block_txs[i]);
     } else if (!config_.keep_invalid_txs_in_cache) {
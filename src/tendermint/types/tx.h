@@ -18,7 +18,7 @@ struct Tx : public Bytes {
   Tx(Bytes&& bytes): Bytes(std::forward<Bytes>(bytes)) {}
 
   TxKey key() const {
-    return crypto::Sha256()(std::span{data(), size()});
+    return crypto::sha256(std::span{data(), size()});
   }
 };
 